@@ -0,0 +1,217 @@
+#include "allpairs.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+
+namespace {
+
+const int BlockSize = 64;
+
+// Mức ghim của lượt tính lại 64 bit: cộng hai giá trị ở mức này vẫn không tràn long long,
+// và đường đi đơn không bao giờ xuống tới đây
+const long long ExactDistanceFloor = LLONG_MIN / 4;
+
+template <typename Distance>
+Distance pinDistance(long long candidate, std::atomic<bool> &pinned);
+
+template <>
+int pinDistance<int>(long long candidate, std::atomic<bool> &pinned) {
+    if (candidate < INT_MIN) {
+        pinned.store(true, std::memory_order_relaxed);
+        return INT_MIN;
+    }
+    return static_cast<int>(candidate);
+}
+
+template <>
+long long pinDistance<long long>(long long candidate, std::atomic<bool> &) {
+    return std::max(candidate, ExactDistanceFloor);
+}
+
+// Cập nhật khối (ib, jb) qua các đỉnh trung gian của khối kb.
+// pinned được bật khi có giá trị bị ghim ở INT_MIN (chỉ với bảng int)
+template <typename Distance>
+void updateBlock(Distance *distance, int *next, int stride, int ib, int jb, int kb, std::atomic<bool> &pinned) {
+    const int kEnd = (kb + 1) * BlockSize;
+    const int iEnd = (ib + 1) * BlockSize;
+    const int jEnd = (jb + 1) * BlockSize;
+    for (int k = kb * BlockSize; k < kEnd; ++k) {
+        const Distance *rowK = distance + static_cast<size_t>(k) * stride;
+        for (int i = ib * BlockSize; i < iEnd; ++i) {
+            Distance *rowI = distance + static_cast<size_t>(i) * stride;
+            const Distance dik = rowI[k];
+            if (dik == GraphEngine::Infinity)
+                continue;
+            int *nextI = next + static_cast<size_t>(i) * stride;
+            for (int j = jb * BlockSize; j < jEnd; ++j) {
+                const Distance dkj = rowK[j];
+                if (dkj == GraphEngine::Infinity)
+                    continue;
+                const long long candidate = static_cast<long long>(dik) + dkj;
+                // Có chu trình âm thì giá trị giảm theo cấp số nhân, ghim lại để ô chéo
+                // đã âm không bị tràn thành dương
+                if (candidate < rowI[j]) {
+                    rowI[j] = pinDistance<Distance>(candidate, pinned);
+                    nextI[j] = nextI[k];
+                }
+            }
+        }
+    }
+}
+
+// Chạy các khối trong danh sách trên nhiều luồng
+template <typename Task>
+void runParallel(const std::vector<std::pair<int, int>> &blocks, int threadCount, Task task) {
+    std::atomic<size_t> cursor(0);
+    auto worker = [&] {
+        for (size_t i = cursor.fetch_add(1); i < blocks.size(); i = cursor.fetch_add(1))
+            task(blocks[i].first, blocks[i].second);
+    };
+    const int extra = std::min<int>(threadCount, static_cast<int>(blocks.size())) - 1;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < extra; ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread &thread : threads)
+        thread.join();
+}
+
+// Floyd-Warshall chia khối trên bảng stride x stride đã khởi tạo. Trả về false nếu bị dừng
+// qua progress; negativeCycle được bật khi có ô chéo âm
+template <typename Distance>
+bool blockedFloydWarshall(Distance *distance, int *next, int vertices, int stride, int threadCount,
+                          const ProgressCallback &progress, bool &negativeCycle, std::atomic<bool> &pinned) {
+    const int blocks = stride / BlockSize;
+    auto update = [&](int ib, int jb, int kb) { updateBlock(distance, next, stride, ib, jb, kb, pinned); };
+    for (int kb = 0; kb < blocks; ++kb) {
+        // Pha 1: khối chéo; pha 2: hàng và cột kb; pha 3: các khối còn lại
+        update(kb, kb, kb);
+
+        std::vector<std::pair<int, int>> cross;
+        for (int b = 0; b < blocks; ++b) {
+            if (b != kb) {
+                cross.push_back({kb, b});
+                cross.push_back({b, kb});
+            }
+        }
+        runParallel(cross, threadCount, [&](int ib, int jb) { update(ib, jb, kb); });
+
+        std::vector<std::pair<int, int>> rest;
+        for (int ib = 0; ib < blocks; ++ib) {
+            for (int jb = 0; jb < blocks; ++jb) {
+                if (ib != kb && jb != kb)
+                    rest.push_back({ib, jb});
+            }
+        }
+        runParallel(rest, threadCount, [&](int ib, int jb) { update(ib, jb, kb); });
+
+        // Ô chéo âm nghĩa là đã có chu trình âm, các khối sau không còn ý nghĩa
+        for (int v = 0; v < vertices && !negativeCycle; ++v) {
+            if (distance[static_cast<size_t>(v) * stride + v] < 0)
+                negativeCycle = true;
+        }
+        if (negativeCycle)
+            break;
+
+        if (progress) {
+            SolverProgress state;
+            state.round = kb + 1;
+            state.totalRounds = blocks;
+            if (!progress(state))
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void AllPairsShortestPaths::clear() {
+    vertices = 0;
+    stride = 0;
+    negativeCycle = false;
+    overflow = false;
+    computed = false;
+    distances.clear();
+    next.clear();
+}
+
+bool AllPairsShortestPaths::isCurrent(const GraphEngine &graph) const {
+    return computed && computedGeneration == graph.generation();
+}
+
+template <typename Distance>
+void AllPairsShortestPaths::initialize(const GraphEngine &graph, std::vector<Distance> &table) {
+    std::fill(table.begin(), table.end(), GraphEngine::Infinity);
+    std::fill(next.begin(), next.end(), -1);
+    for (int v = 0; v < stride; ++v) {
+        table[index(v, v)] = 0;
+        next[index(v, v)] = v;
+    }
+    for (int e = 0; e < graph.edgeCount(); ++e) {
+        const size_t at = index(graph.edgeSource(e), graph.edgeTarget(e));
+        if (graph.edgeWeight(e) < table[at]) {
+            table[at] = graph.edgeWeight(e);
+            next[at] = graph.edgeTarget(e);
+        }
+    }
+}
+
+bool AllPairsShortestPaths::compute(const GraphEngine &graph, int threadCount, const ProgressCallback &progress) {
+    clear();
+    const int n = graph.vertexCount();
+    if (n > MaxVertices)
+        return false;
+    if (threadCount <= 0)
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    const int blocks = (n + BlockSize - 1) / BlockSize;
+    vertices = n;
+    stride = blocks * BlockSize;
+    distances.assign(static_cast<size_t>(stride) * stride, GraphEngine::Infinity);
+    next.assign(static_cast<size_t>(stride) * stride, -1);
+    initialize(graph, distances);
+
+    std::atomic<bool> pinned(false);
+    if (!blockedFloydWarshall(distances.data(), next.data(), n, stride, threadCount, progress, negativeCycle, pinned)) {
+        clear();
+        return false;
+    }
+
+    // Giá trị ghim ở INT_MIN làm sai các tổng dùng nó về sau (kể cả bỏ sót chu trình âm). Ô chéo âm
+    // thì luôn là chu trình thật vì ghim chỉ làm giá trị lớn lên; còn lại thì tính lại trên bảng 64 bit
+    if (pinned && !negativeCycle) {
+        std::vector<long long> exact(distances.size());
+        initialize(graph, exact);
+        if (!blockedFloydWarshall(exact.data(), next.data(), n, stride, threadCount, progress, negativeCycle, pinned)) {
+            clear();
+            return false;
+        }
+        for (size_t at = 0; at < exact.size(); ++at) {
+            overflow = overflow || exact[at] < INT_MIN;
+            distances[at] = GraphEngine::clampDistance(exact[at]);
+        }
+        if (negativeCycle)
+            overflow = false;
+    }
+
+    computed = true;
+    computedGeneration = graph.generation();
+    return true;
+}
+
+std::vector<int> AllPairsShortestPaths::path(int from, int to) const {
+    std::vector<int> result;
+    if (negativeCycle || distance(from, to) == GraphEngine::Infinity)
+        return result;
+    result.push_back(from);
+    // Giới hạn số bước phòng khi chu trình trọng số 0 tạo vòng trên next
+    for (int current = from; current != to; ) {
+        current = next[index(current, to)];
+        result.push_back(current);
+        if (static_cast<int>(result.size()) > vertices)
+            return {};
+    }
+    return result;
+}
@@ -0,0 +1,47 @@
+#ifndef ALLPAIRS_H
+#define ALLPAIRS_H
+
+#include "graphengine.h"
+#include <cstdint>
+#include <vector>
+
+// Khoảng cách giữa mọi cặp đỉnh, dành cho đồ thị nhỏ và dày được truy vấn nhiều lần
+class AllPairsShortestPaths
+{
+public:
+    // Giới hạn để ma trận n x n không quá lớn (khoảng 128 MB cho hai ma trận)
+    static constexpr int MaxVertices = 4096;
+
+    // Floyd-Warshall chia khối để tận dụng cache, các khối độc lập chạy song song. Nếu có giá trị
+    // bị ghim ở INT_MIN thì tính lại một lần trên bảng 64 bit (thêm một bảng tạm gấp đôi kích thước).
+    // Trả về false nếu đồ thị vượt quá MaxVertices hoặc bị dừng qua progress
+    // (mỗi khối đỉnh trung gian tính là một lượt).
+    bool compute(const GraphEngine &graph, int threadCount = 0, const ProgressCallback &progress = nullptr);
+    void clear();
+
+    // Kết quả ứng với đồ thị ở thời điểm generation() này
+    bool isCurrent(const GraphEngine &graph) const;
+    int vertexCount() const { return vertices; }
+    bool hasNegativeCycle() const { return negativeCycle; }
+    // Có khoảng cách thật nhỏ hơn INT_MIN (lưu ở INT_MIN), không phải do chu trình âm
+    bool overflowed() const { return overflow; }
+    int distance(int from, int to) const { return distances[index(from, to)]; }
+    std::vector<int> path(int from, int to) const;  // Rỗng nếu không có đường đi
+
+private:
+    size_t index(int from, int to) const { return static_cast<size_t>(from) * stride + to; }
+    // Đặt bảng về trọng số cạnh trực tiếp (0 trên đường chéo) và next tương ứng
+    template <typename Distance>
+    void initialize(const GraphEngine &graph, std::vector<Distance> &table);
+
+    int vertices = 0;
+    int stride = 0;  // Số cột đã làm tròn lên bội số kích thước khối
+    bool negativeCycle = false;
+    bool overflow = false;
+    bool computed = false;
+    std::uint64_t computedGeneration = 0;
+    std::vector<int> distances;
+    std::vector<int> next;  // Đỉnh kế tiếp trên đường đi from -> to
+};
+
+#endif // ALLPAIRS_H
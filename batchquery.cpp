@@ -0,0 +1,106 @@
+#include "batchquery.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+#include <utility>
+
+namespace {
+
+// Chi phí thật (64 bit) của đường đi; giữa hai đỉnh có nhiều cạnh thì lấy cạnh nhẹ nhất
+// như solver đã relax
+long long pathCost(const CsrView &csr, const std::vector<int> &path) {
+    long long cost = 0;
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        long long best = LLONG_MAX;
+        for (int slot = csr.offsets[path[i]]; slot < csr.offsets[path[i] + 1]; ++slot) {
+            if (csr.targets[slot] == path[i + 1])
+                best = std::min<long long>(best, csr.weights[slot]);
+        }
+        cost += best;
+    }
+    return cost;
+}
+
+} // namespace
+
+std::vector<PathAnswer> answerQueries(const GraphEngine &graph, const std::vector<PathQuery> &queries,
+                                      const SolverOptions &options, int threadCount,
+                                      std::vector<SolverStats> *stats) {
+    std::vector<PathAnswer> answers(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        answers[i].source = queries[i].source;
+        answers[i].target = queries[i].target;
+    }
+
+    // Gom chỉ số truy vấn theo đỉnh nguồn; nguồn không hợp lệ giữ nguyên câu trả lời rỗng
+    std::vector<size_t> order;
+    order.reserve(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (queries[i].source >= 0 && queries[i].source < graph.vertexCount())
+            order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return queries[a].source < queries[b].source;
+    });
+    std::vector<size_t> groupStart;
+    for (size_t k = 0; k < order.size(); ++k) {
+        if (k == 0 || queries[order[k]].source != queries[order[k - 1]].source)
+            groupStart.push_back(k);
+    }
+    groupStart.push_back(order.size());
+    const size_t groupCount = groupStart.size() - 1;
+    if (stats)
+        stats->assign(groupCount, SolverStats());
+    if (groupCount == 0)
+        return answers;
+
+    if (threadCount <= 0)
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threadCount = static_cast<int>(std::min<size_t>(threadCount, groupCount));
+
+    // Các luồng gọi shortestPaths đồng thời nên phải dựng sẵn mọi thứ được tính lười
+    graph.prepareSolvers();
+    const CsrView csr = graph.csrView();
+
+    std::atomic<size_t> cursor(0);
+    auto worker = [&] {
+        for (size_t g = cursor.fetch_add(1); g < groupCount; g = cursor.fetch_add(1)) {
+            const int source = queries[order[groupStart[g]]].source;
+            ShortestPathResult result = graph.shortestPaths(source, options);
+            // Có chu trình âm thì tách đỉnh -vô cùng ra, các đỉnh còn lại trả lời như bình thường
+            std::vector<char> unbounded;
+            if (result.hasNegativeCycle && !result.cancelled) {
+                ShortestPathResult bounded;
+                unbounded.assign(graph.vertexCount(), 0);
+                for (int v : graph.unboundedVertices(result, &bounded))
+                    unbounded[v] = 1;
+                bounded.stats = std::move(result.stats);  // Đã gồm cả pha tìm đỉnh -vô cùng
+                result = std::move(bounded);
+            }
+            for (size_t k = groupStart[g]; k < groupStart[g + 1]; ++k) {
+                PathAnswer &answer = answers[order[k]];
+                if (!unbounded.empty() && answer.target >= 0 && answer.target < graph.vertexCount()
+                    && unbounded[answer.target]) {
+                    answer.hasNegativeCycle = true;
+                } else if (result.reachable(answer.target) && !result.hasNegativeCycle) {
+                    answer.distance = result.distance[answer.target];
+                    answer.path = result.pathTo(answer.target);
+                    // Đích bị ghim ở INT_MIN có thể có chi phí đúng bằng INT_MIN
+                    answer.overflowed = result.overflowed && answer.distance == INT_MIN
+                                        && pathCost(csr, answer.path) < INT_MIN;
+                }
+            }
+            if (stats)
+                (*stats)[g] = std::move(result.stats);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread &thread : threads)
+        thread.join();
+    return answers;
+}
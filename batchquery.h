@@ -0,0 +1,33 @@
+#ifndef BATCHQUERY_H
+#define BATCHQUERY_H
+
+#include "graphengine.h"
+#include <vector>
+
+// Một truy vấn đường đi từ source tới target
+struct PathQuery {
+    int source = -1;
+    int target = -1;
+};
+
+struct PathAnswer {
+    int source = -1;
+    int target = -1;
+    int distance = GraphEngine::Infinity;  // INT_MAX nếu không tới được
+    std::vector<int> path;                 // Rỗng nếu không có đường đi
+    bool hasNegativeCycle = false;         // Khoảng cách tới đích là -vô cùng (đi qua được chu trình âm)
+    bool overflowed = false;               // Chi phí thật nhỏ hơn INT_MIN, distance được ghim ở INT_MIN
+};
+
+// Trả lời nhiều truy vấn cùng lúc. Các truy vấn cùng đỉnh nguồn dùng chung một lần giải,
+// các đỉnh nguồn khác nhau được giải song song trên threadCount luồng (0 = theo số nhân CPU).
+// Mỗi luồng chỉ giữ kết quả của một nguồn tại một thời điểm.
+// Kết quả theo đúng thứ tự của queries. Đồ thị không được sửa trong lúc gọi.
+// Nguồn tới được chu trình âm thì chỉ các đích -vô cùng bị báo chu trình âm; đích khác vẫn có
+// chi phí và đường đi.
+// stats (nếu khác nullptr) nhận bộ đếm của từng lần giải, mỗi đỉnh nguồn một phần tử.
+std::vector<PathAnswer> answerQueries(const GraphEngine &graph, const std::vector<PathQuery> &queries,
+                                      const SolverOptions &options = SolverOptions(), int threadCount = 0,
+                                      std::vector<SolverStats> *stats = nullptr);
+
+#endif // BATCHQUERY_H
@@ -0,0 +1,148 @@
+#include "graphgenerators.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+
+const double Pi = 3.14159265358979323846;
+
+void addBothWays(GraphEngine &graph, int from, int to, int weight) {
+    graph.addEdge(from, to, weight);
+    graph.addEdge(to, from, weight);
+}
+
+void addVertices(GraphEngine &graph, int count) {
+    graph.clear();
+    for (int v = 0; v < count; ++v)
+        graph.addVertex();
+}
+
+} // namespace
+
+void randomGeometricGraph(GraphEngine &graph, int vertexCount, double averageDegree, std::uint32_t seed,
+                          std::vector<float> *positions) {
+    std::mt19937 rng(seed);
+    addVertices(graph, vertexCount);
+    if (vertexCount == 0)
+        return;
+
+    // Mật độ cố định khoảng 2500 pixel vuông mỗi đỉnh, gần với bản đồ trên giao diện
+    const double side = std::sqrt(static_cast<double>(vertexCount)) * 50.0;
+    const double radius = std::sqrt(averageDegree * side * side / (Pi * vertexCount));
+    std::uniform_real_distribution<double> coordinate(0.0, side);
+    std::vector<double> x(vertexCount), y(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        x[v] = coordinate(rng);
+        y[v] = coordinate(rng);
+    }
+
+    // Chia ô cạnh bằng bán kính, mỗi đỉnh chỉ cần xét ô của nó và các ô kề
+    const int cells = std::max(1, static_cast<int>(side / radius));
+    auto cellOf = [&](double value) { return std::min(cells - 1, static_cast<int>(value / side * cells)); };
+    std::vector<std::vector<int>> buckets(static_cast<size_t>(cells) * cells);
+    for (int v = 0; v < vertexCount; ++v)
+        buckets[static_cast<size_t>(cellOf(y[v])) * cells + cellOf(x[v])].push_back(v);
+
+    graph.reserveEdges(static_cast<int>(averageDegree * vertexCount * 1.1));
+    for (int u = 0; u < vertexCount; ++u) {
+        const int cx = cellOf(x[u]);
+        const int cy = cellOf(y[u]);
+        for (int ny = std::max(0, cy - 1); ny <= std::min(cells - 1, cy + 1); ++ny) {
+            for (int nx = std::max(0, cx - 1); nx <= std::min(cells - 1, cx + 1); ++nx) {
+                for (int v : buckets[static_cast<size_t>(ny) * cells + nx]) {
+                    if (v <= u)
+                        continue;
+                    const double distance = std::hypot(x[u] - x[v], y[u] - y[v]);
+                    if (distance <= radius)
+                        addBothWays(graph, u, v, static_cast<int>(distance));
+                }
+            }
+        }
+    }
+
+    if (positions) {
+        positions->resize(2 * static_cast<size_t>(vertexCount));
+        for (int v = 0; v < vertexCount; ++v) {
+            (*positions)[2 * v] = static_cast<float>(x[v]);
+            (*positions)[2 * v + 1] = static_cast<float>(y[v]);
+        }
+    }
+}
+
+void gridGraph(GraphEngine &graph, int rows, int columns, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weight(1, 100);
+    addVertices(graph, rows * columns);
+    graph.reserveEdges(4 * rows * columns);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c) {
+            const int v = r * columns + c;
+            if (c + 1 < columns)
+                addBothWays(graph, v, v + 1, weight(rng));
+            if (r + 1 < rows)
+                addBothWays(graph, v, v + columns, weight(rng));
+        }
+    }
+}
+
+void scaleFreeGraph(GraphEngine &graph, int vertexCount, int edgesPerVertex, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weight(1, 100);
+    addVertices(graph, vertexCount);
+    graph.reserveEdges(2 * edgesPerVertex * vertexCount);
+
+    // Mỗi đầu mút cạnh được ghi một lần, chọn ngẫu nhiên một phần tử là chọn theo bậc
+    std::vector<int> endpoints;
+    endpoints.reserve(2 * static_cast<size_t>(edgesPerVertex) * vertexCount);
+    const int core = std::min(vertexCount, edgesPerVertex + 1);
+    for (int u = 0; u < core; ++u) {
+        for (int v = u + 1; v < core; ++v) {
+            addBothWays(graph, u, v, weight(rng));
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    std::vector<int> targets;
+    for (int u = core; u < vertexCount; ++u) {
+        targets.clear();
+        while (static_cast<int>(targets.size()) < edgesPerVertex) {
+            const int v = endpoints[rng() % endpoints.size()];
+            if (std::find(targets.begin(), targets.end(), v) == targets.end())
+                targets.push_back(v);
+        }
+        for (int v : targets) {
+            addBothWays(graph, u, v, weight(rng));
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+}
+
+void shiftWeights(GraphEngine &graph, int maxShift, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> shift(0, maxShift);
+    std::vector<int> potential(graph.vertexCount());
+    for (int &p : potential)
+        p = shift(rng);
+    for (int e = 0; e < graph.edgeCount(); ++e) {
+        graph.setEdgeWeight(e, graph.edgeWeight(e) + potential[graph.edgeSource(e)]
+                               - potential[graph.edgeTarget(e)]);
+    }
+}
+
+void plantNegativeCycle(GraphEngine &graph, int cycleLength, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    const int n = graph.vertexCount();
+    cycleLength = std::min(cycleLength, n);
+    if (cycleLength < 2)
+        return;
+    std::vector<int> cycle;
+    while (static_cast<int>(cycle.size()) < cycleLength) {
+        const int v = static_cast<int>(rng() % n);
+        if (std::find(cycle.begin(), cycle.end(), v) == cycle.end())
+            cycle.push_back(v);
+    }
+    for (int i = 0; i < cycleLength; ++i)
+        graph.addEdge(cycle[i], cycle[(i + 1) % cycleLength], -1);
+}
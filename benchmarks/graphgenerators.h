@@ -0,0 +1,31 @@
+#ifndef GRAPHGENERATORS_H
+#define GRAPHGENERATORS_H
+
+#include "graphengine.h"
+#include <cstdint>
+#include <vector>
+
+// Các họ đồ thị tổng hợp dùng để đo hiệu năng. Mọi cạnh đều có hai chiều như khi
+// thêm cạnh trên giao diện, trừ cạnh của chu trình âm được cài vào.
+
+// Đỉnh rải đều trong hình vuông, nối các cặp cách nhau không quá bán kính chọn theo
+// bậc trung bình averageDegree; trọng số là khoảng cách Euclid làm tròn xuống như
+// calculateEuclideanDistance. positions (nếu khác nullptr) nhận tọa độ x, y của từng đỉnh.
+void randomGeometricGraph(GraphEngine &graph, int vertexCount, double averageDegree, std::uint32_t seed,
+                          std::vector<float> *positions = nullptr);
+
+// Lưới rows x columns nối bốn hướng, trọng số ngẫu nhiên 1..100
+void gridGraph(GraphEngine &graph, int rows, int columns, std::uint32_t seed);
+
+// Mô hình Barabási–Albert: mỗi đỉnh mới nối tới edgesPerVertex đỉnh cũ với xác suất
+// tỉ lệ theo bậc, cho ra vài đỉnh bậc rất cao; trọng số ngẫu nhiên 1..100
+void scaleFreeGraph(GraphEngine &graph, int vertexCount, int edgesPerVertex, std::uint32_t seed);
+
+// Đổi trọng số w(u, v) thành w(u, v) + p(u) - p(v) với p ngẫu nhiên trong 0..maxShift.
+// Đường đi ngắn nhất giữ nguyên, không sinh chu trình âm nhưng có nhiều cạnh âm.
+void shiftWeights(GraphEngine &graph, int maxShift, std::uint32_t seed);
+
+// Thêm một chu trình có hướng qua cycleLength đỉnh ngẫu nhiên với tổng trọng số âm
+void plantNegativeCycle(GraphEngine &graph, int cycleLength, std::uint32_t seed);
+
+#endif // GRAPHGENERATORS_H
@@ -0,0 +1,93 @@
+// Đo số cạnh relax được mỗi giây: vòng lặp QMap<QChar, int> cũ so với nhân SoA vô hướng và AVX2.
+// Cách dùng: fordbellman_relax_bench [số đỉnh] [số cạnh] [số lượt]
+#include "relaxkernel.h"
+#include <QChar>
+#include <QMap>
+#include <QVector>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Edge {
+    QChar from;
+    QChar to;
+    int weight;
+};
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const char *name, long long relaxations, double elapsed) {
+    std::printf("%-22s %10.3f ms %14.0f cạnh/s\n", name, elapsed * 1000.0, relaxations / elapsed);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const int vertexCount = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const int edgeCount = argc > 2 ? std::atoi(argv[2]) : 200000;
+    const int passes = argc > 3 ? std::atoi(argv[3]) : 10;
+    if (vertexCount < 1 || vertexCount > 0xFFFF || edgeCount < 0 || passes < 1) {
+        std::fprintf(stderr, "Số đỉnh phải trong khoảng 1..65535 (giới hạn của QChar)\n");
+        return 1;
+    }
+
+    std::mt19937 rng(42);
+    std::vector<int> from(edgeCount), to(edgeCount), weight(edgeCount);
+    for (int i = 0; i < edgeCount; ++i) {
+        from[i] = static_cast<int>(rng() % vertexCount);
+        to[i] = static_cast<int>(rng() % vertexCount);
+        weight[i] = static_cast<int>(rng() % 1000) + 1;
+    }
+    const long long relaxations = static_cast<long long>(edgeCount) * passes;
+    std::printf("%d đỉnh, %d cạnh, %d lượt\n", vertexCount, edgeCount, passes);
+
+    // Vòng lặp cũ của onFindShortestPath
+    {
+        QVector<Edge> edges;
+        edges.reserve(edgeCount);
+        for (int i = 0; i < edgeCount; ++i)
+            edges.append({QChar(static_cast<ushort>(from[i])), QChar(static_cast<ushort>(to[i])), weight[i]});
+        QMap<QChar, int> distance;
+        QMap<QChar, QChar> previous;
+        for (int v = 0; v < vertexCount; ++v) {
+            distance[QChar(static_cast<ushort>(v))] = INT_MAX;
+            previous[QChar(static_cast<ushort>(v))] = QChar();
+        }
+        distance[QChar(static_cast<ushort>(0))] = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < passes; ++i) {
+            for (const Edge& edge : edges) {
+                if (distance[edge.from] != INT_MAX && distance[edge.from] + edge.weight < distance[edge.to]) {
+                    distance[edge.to] = distance[edge.from] + edge.weight;
+                    previous[edge.to] = edge.from;
+                }
+            }
+        }
+        report("QMap<QChar, int>", relaxations, seconds(start));
+    }
+
+    const RelaxKernel kernels[] = { relaxEdgesScalar, relaxEdgesAvx2 };
+    for (RelaxKernel kernel : kernels) {
+        if (kernel == relaxEdgesAvx2 && !cpuSupportsAvx2()) {
+            std::printf("%-22s không hỗ trợ trên CPU này\n", "AVX2");
+            continue;
+        }
+        std::vector<int> distance(vertexCount, INT_MAX);
+        std::vector<int> previous(vertexCount, -1);
+        distance[0] = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < passes; ++i)
+            kernel(from.data(), to.data(), weight.data(), edgeCount, distance.data(), previous.data());
+        report(kernel == relaxEdgesAvx2 ? "SoA AVX2" : "SoA scalar", relaxations, seconds(start));
+    }
+    return 0;
+}
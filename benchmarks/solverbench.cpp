@@ -0,0 +1,325 @@
+// Đo các chế độ giải trên các họ đồ thị tổng hợp bằng Google Benchmark.
+// Cách dùng: fordbellman_bench [--benchmark_filter=<regex>] [--benchmark_out=kết_quả.json]
+// Lưu kết quả JSON của hai phiên bản rồi so bằng tools/compare.py của Google Benchmark
+// để bắt hồi quy hiệu năng.
+//
+// Tên benchmark: solve/<họ đồ thị>/<chế độ>/<số đỉnh>, scaling/<kiểu>/<họ>/<số đỉnh>/threads:<n>.
+// time/edge là thời gian chia cho số cạnh của đồ thị; khi dựng với FORDBELLMAN_STATS có thêm
+// time/relax (thời gian chia cho số cạnh thực sự được xét) và passes. peak_rss_MB là đỉnh bộ nhớ của cả
+// tiến trình tới thời điểm đó; muốn đo riêng một chế độ thì lọc để chỉ chạy benchmark đó.
+#include "batchquery.h"
+#include "graphgenerators.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef FORDBELLMAN_BENCH_QMAP
+#include <QChar>
+#include <QMap>
+#include <QVector>
+#endif
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+enum class Family {
+    Geometric,      // Giống đồ thị vẽ trên bản đồ
+    Grid,
+    ScaleFree,
+    Shifted,        // Đồ thị hình học có cạnh âm, không có chu trình âm
+    NegativeCycle   // Đồ thị hình học có một chu trình âm
+};
+
+const char *familyName(Family family) {
+    switch (family) {
+    case Family::Geometric: return "geometric";
+    case Family::Grid: return "grid";
+    case Family::ScaleFree: return "scale-free";
+    case Family::Shifted: return "shifted";
+    case Family::NegativeCycle: return "negative-cycle";
+    }
+    return "";
+}
+
+struct ModeName {
+    const char *name;
+    SolverMode mode;
+};
+
+const ModeName Modes[] = {
+    {"auto", SolverMode::Auto},
+    {"bellman-ford", SolverMode::BellmanFord},
+    {"early-exit", SolverMode::EarlyExit},
+    {"spfa", SolverMode::Spfa},
+    {"parallel", SolverMode::Parallel},
+    {"simd", SolverMode::Vectorized},
+};
+
+const Family Families[] = {
+    Family::Geometric, Family::Grid, Family::ScaleFree, Family::Shifted, Family::NegativeCycle
+};
+
+const int Sizes[] = {1024, 16384, 131072};
+
+// Kích thước dùng cho phần đo khả năng mở rộng theo số luồng
+const int ScalingSize = 131072;
+
+// Đồ thị được sinh một lần cho mỗi (họ, số đỉnh) và dùng lại giữa các benchmark
+GraphEngine &testGraph(Family family, int vertexCount) {
+    static std::map<std::pair<Family, int>, std::unique_ptr<GraphEngine>> graphs;
+    std::unique_ptr<GraphEngine> &graph = graphs[{family, vertexCount}];
+    if (graph)
+        return *graph;
+
+    graph.reset(new GraphEngine);
+    const std::uint32_t seed = 42;
+    switch (family) {
+    case Family::Geometric:
+        randomGeometricGraph(*graph, vertexCount, 8.0, seed);
+        break;
+    case Family::Grid: {
+        int side = 1;
+        while (side * side < vertexCount)
+            ++side;
+        gridGraph(*graph, side, side, seed);
+        break;
+    }
+    case Family::ScaleFree:
+        scaleFreeGraph(*graph, vertexCount, 4, seed);
+        break;
+    case Family::Shifted:
+        randomGeometricGraph(*graph, vertexCount, 8.0, seed);
+        shiftWeights(*graph, 1000, seed);
+        break;
+    case Family::NegativeCycle:
+        randomGeometricGraph(*graph, vertexCount, 8.0, seed);
+        plantNegativeCycle(*graph, 8, seed);
+        break;
+    }
+    // CSR và thế năng Johnson được dựng trước, như khi truy vấn lặp lại trên giao diện
+    graph->prepareSolvers();
+    return *graph;
+}
+
+double peakRssMegabytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0.0;
+    return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0.0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);  // Byte
+#else
+    return usage.ru_maxrss / 1024.0;             // KB
+#endif
+#endif
+}
+
+void setCounters(benchmark::State &state, const GraphEngine &graph, const SolverStats *stats = nullptr) {
+#ifdef FORDBELLMAN_STATS
+    if (stats && stats->relaxationsAttempted > 0) {
+        state.counters["time/relax"] = benchmark::Counter(
+            static_cast<double>(stats->relaxationsAttempted),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+        state.counters["passes"] = static_cast<double>(stats->passes);
+    }
+#else
+    (void)stats;
+#endif
+    state.counters["vertices"] = graph.vertexCount();
+    state.counters["edges"] = graph.edgeCount();
+    state.counters["time/edge"] = benchmark::Counter(
+        graph.edgeCount(), benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.counters["peak_rss_MB"] = peakRssMegabytes();
+}
+
+// Các tổ hợp chạy quá lâu (O(n * m) với n lớn) thì bỏ qua
+bool worthRunning(Family family, SolverMode mode, int vertexCount) {
+    if (mode == SolverMode::BellmanFord)
+        return vertexCount <= 1024;
+    // Có chu trình âm thì mọi biến thể Bellman-Ford đều chạy đủ n lượt
+    if (family == Family::NegativeCycle)
+        return vertexCount <= 16384 && (mode != SolverMode::EarlyExit || vertexCount <= 1024);
+    return true;
+}
+
+void solveBenchmark(benchmark::State &state, Family family, SolverMode mode, int vertexCount) {
+    const GraphEngine &graph = testGraph(family, vertexCount);
+    SolverOptions options;
+    options.mode = mode;
+    SolverStats stats;
+    for (auto _ : state) {
+        ShortestPathResult result = graph.shortestPaths(0, options);
+        benchmark::DoNotOptimize(result.distance.data());
+        stats = std::move(result.stats);
+    }
+    setCounters(state, graph, &stats);
+}
+
+// Johnson khi thế năng chưa có: mỗi lượt làm đồ thị "đổi" để thế năng bị tính lại
+void coldJohnsonBenchmark(benchmark::State &state, Family family, int vertexCount) {
+    GraphEngine &graph = testGraph(family, vertexCount);
+    for (auto _ : state) {
+        state.PauseTiming();
+        graph.setEdgeWeight(0, graph.edgeWeight(0));
+        state.ResumeTiming();
+        ShortestPathResult result = graph.shortestPaths(0);
+        benchmark::DoNotOptimize(result.distance.data());
+    }
+    graph.prepareSolvers();
+    setCounters(state, graph);
+}
+
+void parallelScalingBenchmark(benchmark::State &state, Family family) {
+    const GraphEngine &graph = testGraph(family, ScalingSize);
+    const int threadCount = static_cast<int>(state.range(0));
+    SolverStats stats;
+    for (auto _ : state) {
+        ShortestPathResult result = graph.parallelBellmanFord(0, threadCount);
+        benchmark::DoNotOptimize(result.distance.data());
+        stats = std::move(result.stats);
+    }
+    setCounters(state, graph, &stats);
+}
+
+void batchScalingBenchmark(benchmark::State &state, Family family) {
+    const GraphEngine &graph = testGraph(family, ScalingSize);
+    const int threadCount = static_cast<int>(state.range(0));
+    // 64 nguồn khác nhau, mỗi nguồn 4 đích
+    std::vector<PathQuery> queries;
+    for (int s = 0; s < 64; ++s) {
+        for (int t = 0; t < 4; ++t) {
+            PathQuery query;
+            query.source = static_cast<int>((s * 2654435761u) % graph.vertexCount());
+            query.target = static_cast<int>(((s * 4 + t) * 40503u) % graph.vertexCount());
+            queries.push_back(query);
+        }
+    }
+    for (auto _ : state) {
+        std::vector<PathAnswer> answers = answerQueries(graph, queries, SolverOptions(), threadCount);
+        benchmark::DoNotOptimize(answers.data());
+    }
+    setCounters(state, graph);
+    state.counters["sources/s"] = benchmark::Counter(64, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+#ifdef FORDBELLMAN_BENCH_QMAP
+// Vòng lặp Bellman-Ford ban đầu của onFindShortestPath: đỉnh là QChar, khoảng cách trong QMap,
+// luôn chạy đủ n - 1 lượt rồi kiểm tra chu trình âm
+void qmapBaselineBenchmark(benchmark::State &state, Family family, int vertexCount) {
+    const GraphEngine &graph = testGraph(family, vertexCount);
+    struct Edge {
+        QChar from;
+        QChar to;
+        int weight;
+    };
+    QVector<Edge> edges;
+    for (int e = 0; e < graph.edgeCount(); ++e) {
+        edges.append({QChar(static_cast<ushort>(graph.edgeSource(e))),
+                      QChar(static_cast<ushort>(graph.edgeTarget(e))), graph.edgeWeight(e)});
+    }
+
+    for (auto _ : state) {
+        QMap<QChar, int> distance;
+        QMap<QChar, QChar> previous;
+        for (int v = 0; v < graph.vertexCount(); ++v) {
+            distance[QChar(static_cast<ushort>(v))] = INT_MAX;
+            previous[QChar(static_cast<ushort>(v))] = QChar();
+        }
+        distance[QChar(static_cast<ushort>(0))] = 0;
+
+        for (int i = 0; i < graph.vertexCount() - 1; ++i) {
+            for (const Edge& edge : edges) {
+                if (distance[edge.from] != INT_MAX && distance[edge.from] + edge.weight < distance[edge.to]) {
+                    distance[edge.to] = distance[edge.from] + edge.weight;
+                    previous[edge.to] = edge.from;
+                }
+            }
+        }
+        bool hasNegativeCycle = false;
+        for (const Edge& edge : edges) {
+            if (distance[edge.from] != INT_MAX && distance[edge.from] + edge.weight < distance[edge.to]) {
+                hasNegativeCycle = true;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(hasNegativeCycle);
+    }
+    setCounters(state, graph);
+}
+#endif
+
+void registerBenchmarks() {
+    const int hardwareThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (Family family : Families) {
+        for (int n : Sizes) {
+            const std::string prefix = std::string("solve/") + familyName(family) + "/";
+#ifdef FORDBELLMAN_BENCH_QMAP
+            if (n <= 1024) {
+                benchmark::RegisterBenchmark((prefix + "qmap-baseline/" + std::to_string(n)).c_str(),
+                                             qmapBaselineBenchmark, family, n)
+                    ->Unit(benchmark::kMillisecond);
+            }
+#endif
+            for (const ModeName &mode : Modes) {
+                if (!worthRunning(family, mode.mode, n))
+                    continue;
+                auto *bench = benchmark::RegisterBenchmark((prefix + mode.name + "/" + std::to_string(n)).c_str(),
+                                                           solveBenchmark, family, mode.mode, n);
+                bench->Unit(benchmark::kMillisecond);
+                if (mode.mode == SolverMode::Parallel)
+                    bench->UseRealTime();
+            }
+            if (family == Family::Shifted || (family == Family::NegativeCycle && n <= 16384)) {
+                benchmark::RegisterBenchmark((prefix + "auto-cold/" + std::to_string(n)).c_str(),
+                                             coldJohnsonBenchmark, family, n)
+                    ->Unit(benchmark::kMillisecond);
+            }
+        }
+    }
+
+    // Số luồng 1, 2, 4, ... tới số nhân CPU
+    for (Family family : {Family::Geometric, Family::ScaleFree}) {
+        const std::string suffix = std::string(familyName(family)) + "/" + std::to_string(ScalingSize);
+        auto *parallel = benchmark::RegisterBenchmark(("scaling/parallel/" + suffix).c_str(),
+                                                      parallelScalingBenchmark, family);
+        auto *batch = benchmark::RegisterBenchmark(("scaling/batch/" + suffix).c_str(),
+                                                   batchScalingBenchmark, family);
+        for (auto *bench : {parallel, batch}) {
+            bench->ArgName("threads")->Unit(benchmark::kMillisecond)->UseRealTime();
+            for (int threads = 1; threads < hardwareThreads; threads *= 2)
+                bench->Arg(threads);
+            bench->Arg(hardwareThreads);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    registerBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
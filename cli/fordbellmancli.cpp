@@ -0,0 +1,172 @@
+// Trả lời hàng loạt truy vấn đường đi ngắn nhất không cần màn hình.
+// Cách dùng: fordbellman-cli [--mode <chế độ>] [--threads <n>] [--stats] [--trace <file.json>]
+//                            <file đồ thị> <file truy vấn>
+// Mỗi truy vấn in một dòng "<nguồn> <đích> <chi phí> <đỉnh 1> <đỉnh 2> ..." ra stdout;
+// chi phí là "inf" nếu không có đường đi, "negative-cycle" nếu đích đi qua được chu trình âm
+// (khoảng cách -vô cùng) và "<-2147483648" nếu chi phí nhỏ hơn INT_MIN.
+// Số đỉnh trong file truy vấn và ở đầu ra đánh số giống file đồ thị (từ 1 với .gr, từ 0 với .csv/.fbg).
+// --stats in tổng bộ đếm ra stderr, --trace ghi các pha dạng Chrome trace event; cả hai chỉ có
+// số liệu khi dựng với FORDBELLMAN_STATS.
+#include "batchquery.h"
+#include "graphio.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct ModeName {
+    const char *name;
+    SolverMode mode;
+};
+
+const ModeName Modes[] = {
+    {"auto", SolverMode::Auto},
+    {"bellman-ford", SolverMode::BellmanFord},
+    {"early-exit", SolverMode::EarlyExit},
+    {"spfa", SolverMode::Spfa},
+    {"parallel", SolverMode::Parallel},
+    {"simd", SolverMode::Vectorized},
+};
+
+int usage() {
+    std::fprintf(stderr,
+                 "Cách dùng: fordbellman-cli [--mode auto|bellman-ford|early-exit|spfa|parallel|simd]\n"
+                 "                           [--threads <n>] [--stats] [--trace <file.json>]\n"
+                 "                           <file đồ thị> <file truy vấn>\n");
+    return 2;
+}
+
+double milliseconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    SolverOptions options;
+    int threadCount = 0;
+    bool printStats = false;
+    const char *tracePath = nullptr;
+    std::vector<const char *> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            bool found = false;
+            for (const ModeName &mode : Modes) {
+                if (std::strcmp(mode.name, name) == 0) {
+                    options.mode = mode.mode;
+                    found = true;
+                }
+            }
+            if (!found) {
+                std::fprintf(stderr, "Chế độ không hợp lệ: %s\n", name);
+                return usage();
+            }
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--stats") == 0) {
+            printStats = true;
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            return usage();
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.size() != 2)
+        return usage();
+
+    const auto start = std::chrono::steady_clock::now();
+    GraphEngine graph;
+    std::string error;
+    if (!loadGraph(files[0], graph, nullptr, &error)) {
+        std::fprintf(stderr, "%s: %s\n", files[0], error.c_str());
+        return 1;
+    }
+    const int firstVertex = graphFormatFromPath(files[0]) == GraphFormat::Dimacs ? 1 : 0;
+    std::vector<PathQuery> queries;
+    if (!loadQueries(files[1], queries, firstVertex, graph.vertexCount(), &error)) {
+        std::fprintf(stderr, "%s: %s\n", files[1], error.c_str());
+        return 1;
+    }
+    const double loadTime = milliseconds(start);
+
+    // Chế độ song song: khi số đỉnh nguồn đủ lấp các luồng thì mỗi lần giải chỉ cần một luồng,
+    // ít nguồn hơn thì chia số luồng còn dư cho từng lần giải
+    if (options.mode == SolverMode::Parallel && options.threadCount == 0) {
+        const int totalThreads = threadCount > 0
+            ? threadCount : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<int> sources;
+        sources.reserve(queries.size());
+        for (const PathQuery &query : queries)
+            sources.push_back(query.source);
+        std::sort(sources.begin(), sources.end());
+        const int sourceCount = static_cast<int>(std::unique(sources.begin(), sources.end()) - sources.begin());
+        options.threadCount = sourceCount >= totalThreads ? 1 : totalThreads / std::max(1, sourceCount);
+    }
+    const auto solveStart = std::chrono::steady_clock::now();
+    std::vector<SolverStats> stats;
+    const std::vector<PathAnswer> answers = answerQueries(graph, queries, options, threadCount,
+                                                          printStats || tracePath ? &stats : nullptr);
+    const double solveTime = milliseconds(solveStart);
+
+    // Ghi ra bộ đệm rồi xả một lần, tránh hàng triệu lần gọi printf nhỏ
+    std::string out;
+    out.reserve(answers.size() * 32);
+    for (const PathAnswer &answer : answers) {
+        out += std::to_string(answer.source + firstVertex);
+        out += ' ';
+        out += std::to_string(answer.target + firstVertex);
+        out += ' ';
+        if (answer.hasNegativeCycle) {
+            out += "negative-cycle";
+        } else if (answer.path.empty()) {
+            out += "inf";
+        } else {
+            if (answer.overflowed)
+                out += '<';
+            out += std::to_string(answer.distance);
+            for (int v : answer.path) {
+                out += ' ';
+                out += std::to_string(v + firstVertex);
+            }
+        }
+        out += '\n';
+        if (out.size() > (1 << 20)) {
+            std::fwrite(out.data(), 1, out.size(), stdout);
+            out.clear();
+        }
+    }
+    std::fwrite(out.data(), 1, out.size(), stdout);
+
+    std::fprintf(stderr, "%d đỉnh, %d cạnh, %zu truy vấn: đọc %.1f ms, giải %.1f ms\n",
+                 graph.vertexCount(), graph.edgeCount(), queries.size(), loadTime, solveTime);
+
+    if (printStats) {
+#ifndef FORDBELLMAN_STATS
+        std::fprintf(stderr, "Dựng lại với -DFORDBELLMAN_STATS=ON để có bộ đếm\n");
+#endif
+        SolverStats total;
+        for (const SolverStats &run : stats)
+            total.add(run);
+        std::fprintf(stderr, "%zu lần giải: %lld lượt, %lld lần relax (%lld thành công), %lld lần đưa vào hàng đợi\n",
+                     stats.size(), total.passes, total.relaxationsAttempted, total.relaxationsSucceeded,
+                     total.queuePushes);
+        const SolverPhase phases[] = {SolverPhase::Init, SolverPhase::Potential, SolverPhase::Relax,
+                                      SolverPhase::NegativeCycleCheck, SolverPhase::PathReconstruction};
+        for (SolverPhase phase : phases)
+            std::fprintf(stderr, "  %-22s %10.3f ms\n", solverPhaseName(phase), total.phaseDuration(phase) / 1e6);
+    }
+    if (tracePath && !writeChromeTrace(tracePath, stats, &error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include "dynamicshortestpaths.h"
+#include <climits>
+#include <utility>
+
+DynamicShortestPaths::DynamicShortestPaths(const GraphEngine &graph)
+    : graph(graph)
+{
+}
+
+void DynamicShortestPaths::reset(int source, const SolverOptions &options) {
+    reset(graph.shortestPaths(source, options));
+}
+
+void DynamicShortestPaths::reset(ShortestPathResult result) {
+    shortest = std::move(result);
+    syncedGeneration = graph.generation();
+    valid = shortest.source >= 0 && shortest.source < graph.vertexCount()
+            && !shortest.distance.empty() && !shortest.cancelled;
+
+    const int n = graph.vertexCount();
+    outEdges.assign(n, std::vector<int>());
+    inEdges.assign(n, std::vector<int>());
+    for (int e = 0; e < graph.edgeCount(); ++e) {
+        outEdges[graph.edgeSource(e)].push_back(e);
+        inEdges[graph.edgeTarget(e)].push_back(e);
+    }
+    inQueue.assign(n, 0);
+    queue.clear();
+    if (valid && !shortest.hasNegativeCycle)
+        rebuildParentEdges();
+}
+
+void DynamicShortestPaths::invalidate() {
+    valid = false;
+}
+
+bool DynamicShortestPaths::isValid() const {
+    return valid && syncedGeneration == graph.generation();
+}
+
+// Ghi nhận một thay đổi; trả về false nếu cây không sửa tiếp được
+bool DynamicShortestPaths::noteChange() {
+    ++syncedGeneration;
+    // Khi đã có chu trình âm thì không còn cây để sửa, lần truy vấn sau sẽ tính lại. Khoảng cách
+    // bị ghim ở INT_MIN cũng vậy: so sánh trên giá trị ghim không còn đúng
+    if (shortest.hasNegativeCycle || shortest.overflowed)
+        valid = false;
+    return isValid();
+}
+
+void DynamicShortestPaths::rebuildParentEdges() {
+    // Solver chỉ trả về đỉnh cha, tìm lại cạnh "chặt" tương ứng
+    const int n = graph.vertexCount();
+    parentEdge.assign(n, -1);
+    depth.assign(n, 0);
+    for (int v = 0; v < n; ++v) {
+        const int u = shortest.previous[v];
+        if (u == -1)
+            continue;
+        for (int e : inEdges[v]) {
+            if (graph.edgeSource(e) == u
+                && static_cast<long long>(shortest.distance[u]) + graph.edgeWeight(e) == shortest.distance[v]) {
+                parentEdge[v] = e;
+                break;
+            }
+        }
+    }
+    // Độ sâu tính theo thứ tự BFS từ nguồn trên cây
+    std::vector<int> order{shortest.source};
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (int e : outEdges[order[head]]) {
+            const int v = graph.edgeTarget(e);
+            if (parentEdge[v] == e) {
+                depth[v] = depth[order[head]] + 1;
+                order.push_back(v);
+            }
+        }
+    }
+}
+
+void DynamicShortestPaths::vertexAdded() {
+    if (!noteChange())
+        return;
+    shortest.distance.push_back(GraphEngine::Infinity);
+    shortest.previous.push_back(-1);
+    parentEdge.push_back(-1);
+    depth.push_back(0);
+    outEdges.emplace_back();
+    inEdges.emplace_back();
+    inQueue.push_back(0);
+}
+
+void DynamicShortestPaths::edgeAdded(int edge) {
+    if (!noteChange())
+        return;
+    outEdges[graph.edgeSource(edge)].push_back(edge);
+    inEdges[graph.edgeTarget(edge)].push_back(edge);
+    if (relaxEdge(edge))
+        propagate();
+}
+
+void DynamicShortestPaths::edgeWeightChanged(int edge, int oldWeight) {
+    if (!noteChange())
+        return;
+    const int weight = graph.edgeWeight(edge);
+    if (weight < oldWeight) {
+        // Giảm trọng số: chỉ lan truyền từ đỉnh đích của cạnh
+        if (relaxEdge(edge))
+            propagate();
+    } else if (weight > oldWeight && parentEdge[graph.edgeTarget(edge)] == edge) {
+        // Tăng trọng số cạnh trên cây: chỉ cây con bên dưới bị ảnh hưởng
+        repairSubtree(graph.edgeTarget(edge));
+    }
+}
+
+// Relax một cạnh, trả về true nếu đỉnh đích được đưa vào hàng đợi
+bool DynamicShortestPaths::relaxEdge(int edge) {
+    const int u = graph.edgeSource(edge);
+    const int v = graph.edgeTarget(edge);
+    const int du = shortest.distance[u];
+    if (du == GraphEngine::Infinity)
+        return false;
+    const long long candidate = static_cast<long long>(du) + graph.edgeWeight(edge);
+    if (candidate >= shortest.distance[v])
+        return false;
+    // Tổng dưới INT_MIN sẽ bị ghim và các lần relax sau so sánh sai, bỏ cây để giải lại bằng 64 bit
+    if (candidate < INT_MIN) {
+        valid = false;
+        return false;
+    }
+
+    shortest.distance[v] = GraphEngine::clampDistance(candidate);
+    shortest.previous[v] = u;
+    parentEdge[v] = edge;
+    depth[v] = depth[u] + 1;
+    // Đường đi có từ n cạnh trở lên nghĩa là vừa tạo ra chu trình âm. Khoảng cách đang dở
+    // dang và chưa lấy được chu trình, để lần truy vấn sau giải lại từ đầu
+    if (depth[v] >= graph.vertexCount()) {
+        shortest.hasNegativeCycle = true;
+        valid = false;
+        return false;
+    }
+    if (!inQueue[v]) {
+        inQueue[v] = 1;
+        queue.push_back(v);
+    }
+    return true;
+}
+
+void DynamicShortestPaths::propagate() {
+    for (size_t head = 0; head < queue.size() && valid; ++head) {
+        const int u = queue[head];
+        inQueue[u] = 0;
+        for (int e : outEdges[u]) {
+            relaxEdge(e);
+            if (!valid)
+                break;
+        }
+    }
+    for (int v : queue)
+        inQueue[v] = 0;
+    queue.clear();
+}
+
+void DynamicShortestPaths::repairSubtree(int root) {
+    // Gom cây con gốc root theo các cạnh cha
+    std::vector<int> subtree{root};
+    std::vector<char> inSubtree(graph.vertexCount(), 0);
+    inSubtree[root] = 1;
+    for (size_t head = 0; head < subtree.size(); ++head) {
+        for (int e : outEdges[subtree[head]]) {
+            const int v = graph.edgeTarget(e);
+            if (parentEdge[v] == e && !inSubtree[v]) {
+                inSubtree[v] = 1;
+                subtree.push_back(v);
+            }
+        }
+    }
+
+    for (int v : subtree) {
+        shortest.distance[v] = GraphEngine::Infinity;
+        shortest.previous[v] = -1;
+        parentEdge[v] = -1;
+    }
+
+    // Khoảng cách ngoài cây con vẫn đúng; lấy cạnh tốt nhất đi từ ngoài vào làm điểm xuất phát
+    for (int v : subtree) {
+        for (int e : inEdges[v]) {
+            if (!inSubtree[graph.edgeSource(e)])
+                relaxEdge(e);
+        }
+    }
+    propagate();
+}
@@ -0,0 +1,51 @@
+#ifndef DYNAMICSHORTESTPATHS_H
+#define DYNAMICSHORTESTPATHS_H
+
+#include "graphengine.h"
+#include <cstdint>
+#include <vector>
+
+// Cây đường đi ngắn nhất từ một đỉnh nguồn, được sửa cục bộ khi đồ thị thay đổi
+// thay vì chạy lại toàn bộ thuật toán.
+// Sau mỗi thay đổi trên GraphEngine phải gọi đúng một hàm thông báo tương ứng
+// (vertexAdded, edgeAdded, edgeWeightChanged); nếu bỏ sót, isValid() trả về false.
+// Cây cũng mất hiệu lực khi có chu trình âm hoặc khoảng cách nhỏ hơn INT_MIN.
+class DynamicShortestPaths
+{
+public:
+    explicit DynamicShortestPaths(const GraphEngine &graph);
+
+    // Tính lại toàn bộ cây từ source bằng solver đã chọn
+    void reset(int source, const SolverOptions &options = SolverOptions());
+    // Nhận kết quả đã tính sẵn (ví dụ trên luồng khác) cho đồ thị hiện tại
+    void reset(ShortestPathResult result);
+    void invalidate();
+    // Cây khớp với đồ thị hiện tại và dùng được mà không cần tính lại
+    bool isValid() const;
+    int source() const { return shortest.source; }
+    const ShortestPathResult &result() const { return shortest; }
+
+    void vertexAdded();
+    void edgeAdded(int edge);
+    void edgeWeightChanged(int edge, int oldWeight);
+
+private:
+    bool noteChange();
+    bool relaxEdge(int edge);
+    void propagate();
+    void repairSubtree(int root);
+    void rebuildParentEdges();
+
+    const GraphEngine &graph;
+    ShortestPathResult shortest;
+    std::vector<int> parentEdge;  // Cạnh đi vào mỗi đỉnh trên cây, -1 nếu không có
+    std::vector<int> depth;       // Số cạnh trên đường đi từ nguồn
+    std::vector<std::vector<int>> outEdges;
+    std::vector<std::vector<int>> inEdges;
+    std::vector<int> queue;
+    std::vector<char> inQueue;
+    std::uint64_t syncedGeneration = 0;
+    bool valid = false;
+};
+
+#endif // DYNAMICSHORTESTPATHS_H
@@ -0,0 +1,757 @@
+#include "graphengine.h"
+#include "relaxkernel.h"
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <queue>
+
+namespace {
+
+// Dijkstra báo tiến độ sau mỗi chừng này đỉnh được chốt
+const int DijkstraProgressInterval = 1024;
+
+// Mức ghim của exactBellmanFord: đường đi không chứa chu trình luôn lớn hơn -(2^31 * 2^31),
+// nên chỉ đỉnh bị chu trình âm kéo xuống mới chạm tới đây, và cộng thêm một cạnh không tràn
+const long long ExactDistanceFloor = LLONG_MIN / 4;
+
+// Gọi callback nếu có; trả về false khi phía gọi yêu cầu dừng
+bool reportProgress(const ProgressCallback &progress, int round, int totalRounds, const int *distance) {
+    if (!progress)
+        return true;
+    SolverProgress state;
+    state.round = round;
+    state.totalRounds = totalRounds;
+    state.distance = distance;
+    return progress(state);
+}
+
+} // namespace
+
+const char *algorithmName(Algorithm algorithm) {
+    switch (algorithm) {
+    case Algorithm::BellmanFord: return "Bellman-Ford";
+    case Algorithm::Spfa: return "SPFA";
+    case Algorithm::Dijkstra: return "Dijkstra";
+    case Algorithm::Johnson: return "Johnson";
+    case Algorithm::ParallelBellmanFord: return "Parallel Bellman-Ford";
+    case Algorithm::VectorizedBellmanFord: return "Bellman-Ford (SIMD)";
+    }
+    return "";
+}
+
+bool ShortestPathResult::reachable(int target) const {
+    return target >= 0 && target < static_cast<int>(distance.size())
+           && distance[target] != GraphEngine::Infinity;
+}
+
+std::vector<int> ShortestPathResult::pathTo(int target) const {
+    std::vector<int> path;
+    if (hasNegativeCycle || cancelled || !reachable(target))
+        return path;
+
+    // Lần ngược theo previous, giới hạn số bước để tránh lặp vô hạn
+    SOLVER_STATS(PhaseClock clock(stats, SolverPhase::PathReconstruction);)
+    for (int current = target; current != -1; current = previous[current]) {
+        path.push_back(current);
+        if (path.size() > distance.size()) {
+            path.clear();
+            break;
+        }
+    }
+    std::reverse(path.begin(), path.end());
+    SOLVER_STATS(clock.stop();)
+    return path;
+}
+
+void GraphEngine::clear() {
+    external = false;
+    csr = CsrView();
+    vertices = 0;
+    negativeEdges = 0;
+    ++revision;
+    edgeFrom.clear();
+    edgeTo.clear();
+    edgeWeights.clear();
+    csrDirty = true;
+}
+
+int GraphEngine::addVertex() {
+    detach();
+    csrDirty = true;
+    ++revision;
+    return vertices++;
+}
+
+int GraphEngine::addEdge(int from, int to, int weight) {
+    assert(from >= 0 && from < vertices && to >= 0 && to < vertices);
+    detach();
+    edgeFrom.push_back(from);
+    edgeTo.push_back(to);
+    edgeWeights.push_back(weight);
+    if (weight < 0)
+        ++negativeEdges;
+    csrDirty = true;
+    ++revision;
+    return edgeCount() - 1;
+}
+
+void GraphEngine::setEdgeWeight(int edge, int weight) {
+    detach();
+    negativeEdges += (weight < 0) - (edgeWeights[edge] < 0);
+    edgeWeights[edge] = weight;
+    ++revision;
+    // Đổi trọng số không làm thay đổi cấu trúc, chỉ cập nhật tại chỗ
+    if (!csrDirty)
+        csrWeights[edgeSlot[edge]] = weight;
+}
+
+void GraphEngine::reserveEdges(int count) {
+    detach();
+    edgeFrom.reserve(count);
+    edgeTo.reserve(count);
+    edgeWeights.reserve(count);
+}
+
+void GraphEngine::attach(const CsrView &view) {
+    clear();
+    csr = view;
+    external = true;
+    csrDirty = false;
+    vertices = view.vertexCount;
+    for (int e = 0; e < view.edgeCount; ++e) {
+        if (view.weights[e] < 0)
+            ++negativeEdges;
+    }
+}
+
+void GraphEngine::detach() {
+    if (!external)
+        return;
+
+    // Chép các cạnh từ vùng nhớ ngoài, giữ nguyên chỉ số cạnh
+    edgeFrom.assign(csr.sources, csr.sources + csr.edgeCount);
+    edgeTo.assign(csr.targets, csr.targets + csr.edgeCount);
+    edgeWeights.assign(csr.weights, csr.weights + csr.edgeCount);
+    external = false;
+    csr = CsrView();
+    csrDirty = true;
+}
+
+CsrView GraphEngine::csrView() const {
+    buildCsr();
+    return csr;
+}
+
+void GraphEngine::buildCsr() const {
+    if (!csrDirty)
+        return;
+
+    const int m = edgeCount();
+    rowOffsets.assign(vertices + 1, 0);
+    for (int e = 0; e < m; ++e)
+        ++rowOffsets[edgeFrom[e] + 1];
+    for (int v = 0; v < vertices; ++v)
+        rowOffsets[v + 1] += rowOffsets[v];
+
+    // Sắp xếp đếm theo đỉnh nguồn, giữ nguyên thứ tự thêm cạnh trong mỗi hàng
+    std::vector<int> cursor(rowOffsets.begin(), rowOffsets.end() - 1);
+    csrSources.resize(m);
+    csrTargets.resize(m);
+    csrWeights.resize(m);
+    edgeSlot.resize(m);
+    for (int e = 0; e < m; ++e) {
+        int slot = cursor[edgeFrom[e]]++;
+        csrSources[slot] = edgeFrom[e];
+        csrTargets[slot] = edgeTo[e];
+        csrWeights[slot] = edgeWeights[e];
+        edgeSlot[e] = slot;
+    }
+
+    csr = CsrView();
+    csr.vertexCount = vertices;
+    csr.edgeCount = m;
+    csr.offsets = rowOffsets.data();
+    csr.sources = csrSources.data();
+    csr.targets = csrTargets.data();
+    csr.weights = csrWeights.data();
+    csrDirty = false;
+}
+
+ShortestPathResult GraphEngine::initResult(int source) const {
+    ShortestPathResult result;
+    SOLVER_STATS(PhaseClock clock(result.stats, SolverPhase::Init);)
+    result.source = source;
+    result.distance.assign(vertices, Infinity);
+    result.previous.assign(vertices, -1);
+    if (source >= 0 && source < vertices)
+        result.distance[source] = 0;
+    SOLVER_STATS(clock.stop();)
+    return result;
+}
+
+void GraphEngine::prepareSolvers() const {
+    buildCsr();
+    // Chế độ tự động chỉ cần thế năng khi có cạnh âm
+    if (negativeEdges > 0) {
+        bool cancelled = false;
+        buildPotential(nullptr, &cancelled, nullptr);
+    }
+}
+
+ShortestPathResult GraphEngine::shortestPaths(int source, const SolverOptions &options) const {
+    switch (options.mode) {
+    case SolverMode::Auto: {
+        if (negativeEdges == 0)
+            return dijkstra(source, options.progress);
+        ShortestPathResult result = johnson(source, options.progress);
+        // Johnson không dùng được khi đồ thị có chu trình âm, để Bellman-Ford báo lỗi
+        if (!result.distance.empty() || vertices == 0 || result.cancelled)
+            return result;
+        ShortestPathResult fallback = bellmanFord(source, true, options.progress);
+        SOLVER_STATS(fallback.stats.add(result.stats);)
+        return fallback;
+    }
+    case SolverMode::BellmanFord:
+        return bellmanFord(source, false, options.progress);
+    case SolverMode::EarlyExit:
+        return bellmanFord(source, true, options.progress);
+    case SolverMode::Spfa:
+        return spfa(source, options.progress);
+    case SolverMode::Parallel:
+        return parallelBellmanFord(source, options.threadCount, options.progress);
+    case SolverMode::Vectorized:
+        return vectorizedBellmanFord(source, options.progress);
+    }
+    return bellmanFord(source, true, options.progress);
+}
+
+ShortestPathResult GraphEngine::bellmanFord(int source, bool earlyExit, const ProgressCallback &progress) const {
+    buildCsr();
+
+    ShortestPathResult result = initResult(source);
+    if (source < 0 || source >= vertices)
+        return result;
+
+    int *distance = result.distance.data();
+    int *previous = result.previous.data();
+    SOLVER_STATS(long long attempted = 0, succeeded = 0;)
+    SOLVER_STATS(PhaseClock relaxClock(result.stats, SolverPhase::Relax);)
+
+    // Thuật toán Bellman-Ford: relax toàn bộ cạnh tối đa vertices - 1 lượt
+    bool converged = false;
+    for (int i = 0; i < vertices - 1; ++i) {
+        bool changed = false;
+        SOLVER_STATS(++result.stats.passes;)
+        for (int u = 0; u < vertices; ++u) {
+            const int du = distance[u];
+            if (du == Infinity)
+                continue;
+            for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+                const int v = csr.targets[k];
+                const long long candidate = static_cast<long long>(du) + csr.weights[k];
+                SOLVER_STATS(++attempted;)
+                if (candidate < distance[v]) {
+                    distance[v] = clampDistance(candidate);
+                    previous[v] = u;
+                    changed = true;
+                    SOLVER_STATS(++succeeded;)
+                }
+            }
+        }
+        // Lượt không thay đổi gì thì các lượt sau cũng vậy, không thể có chu trình âm
+        if (earlyExit && !changed) {
+            converged = true;
+            break;
+        }
+        if (!reportProgress(progress, i + 1, vertices - 1, distance)) {
+            result.cancelled = true;
+            break;
+        }
+    }
+    SOLVER_STATS(relaxClock.stop();
+                 result.stats.relaxationsAttempted = attempted;
+                 result.stats.relaxationsSucceeded = succeeded;)
+    if (converged || result.cancelled) {
+        resolveOverflow(result);
+        return result;
+    }
+
+    // Kiểm tra chu trình âm: nếu vẫn còn cạnh relax được thì relax nó, đỉnh đích trở thành
+    // đỉnh được cập nhật ở lượt thứ vertices và dẫn ngược về chu trình
+    SOLVER_STATS(PhaseClock checkClock(result.stats, SolverPhase::NegativeCycleCheck);)
+    int witness = -1;
+    for (int u = 0; u < vertices && witness == -1; ++u) {
+        const int du = distance[u];
+        if (du == Infinity)
+            continue;
+        for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+            const int v = csr.targets[k];
+            const long long candidate = static_cast<long long>(du) + csr.weights[k];
+            if (candidate < distance[v]) {
+                distance[v] = clampDistance(candidate);
+                previous[v] = u;
+                witness = v;
+                break;
+            }
+        }
+    }
+    if (witness != -1) {
+        result.hasNegativeCycle = true;
+        result.negativeCycle = traceNegativeCycle(previous, witness);
+    }
+    SOLVER_STATS(checkClock.stop();)
+    resolveOverflow(result);
+    return result;
+}
+
+ShortestPathResult GraphEngine::vectorizedBellmanFord(int source, const ProgressCallback &progress) const {
+    buildCsr();
+
+    ShortestPathResult result = initResult(source);
+    result.algorithm = Algorithm::VectorizedBellmanFord;
+    if (source < 0 || source >= vertices)
+        return result;
+
+    // Quét toàn bộ mảng cạnh mỗi lượt; lượt thứ vertices còn cập nhật nghĩa là có chu trình âm
+    SOLVER_STATS(PhaseClock relaxClock(result.stats, SolverPhase::Relax);)
+    const RelaxKernel relax = selectRelaxKernel();
+    bool converged = false;
+    std::vector<int> beforeLastPass;
+    for (int i = 0; i < vertices; ++i) {
+        // Giữ khoảng cách trước lượt cuối để biết đỉnh nào còn được cập nhật ở lượt đó
+        if (i == vertices - 1)
+            beforeLastPass = result.distance;
+        SOLVER_STATS(++result.stats.passes;
+                     result.stats.relaxationsAttempted += csr.edgeCount;)
+        if (!relax(csr.sources, csr.targets, csr.weights, csr.edgeCount,
+                   result.distance.data(), result.previous.data())) {
+            converged = true;
+            break;
+        }
+        if (!reportProgress(progress, i + 1, vertices, result.distance.data())) {
+            result.cancelled = true;
+            break;
+        }
+    }
+    SOLVER_STATS(relaxClock.stop();)
+    if (!converged && !result.cancelled) {
+        SOLVER_STATS(PhaseClock checkClock(result.stats, SolverPhase::NegativeCycleCheck);)
+        // Lượt cuối có thể chỉ gồm các cập nhật bị ghim ở INT_MIN, khi đó khoảng cách không đổi
+        // và đỉnh đã bị ghim được dùng làm điểm xuất phát
+        int witness = 0;
+        while (witness < vertices && result.distance[witness] == beforeLastPass[witness])
+            ++witness;
+        if (witness == vertices)
+            witness = static_cast<int>(std::find(result.distance.begin(), result.distance.end(), INT_MIN)
+                                       - result.distance.begin());
+        result.hasNegativeCycle = true;
+        result.negativeCycle = traceNegativeCycle(result.previous.data(), witness);
+        SOLVER_STATS(checkClock.stop();)
+    }
+    resolveOverflow(result);
+    return result;
+}
+
+ShortestPathResult GraphEngine::spfa(int source, const ProgressCallback &progress) const {
+    buildCsr();
+
+    ShortestPathResult result = initResult(source);
+    result.algorithm = Algorithm::Spfa;
+    if (source < 0 || source >= vertices)
+        return result;
+
+    int *distance = result.distance.data();
+    int *previous = result.previous.data();
+
+    // Số cạnh trên đường đi hiện tại tới mỗi đỉnh, tăng mỗi lần relax.
+    // Đường đi có từ vertices cạnh trở lên chắc chắn chứa chu trình âm.
+    std::vector<int> edgesOnPath(vertices, 0);
+    std::vector<char> inQueue(vertices, 0);
+    std::deque<int> queue;
+    queue.push_back(source);
+    inQueue[source] = 1;
+    SOLVER_STATS(long long attempted = 0, succeeded = 0, pushes = 1;)
+    SOLVER_STATS(PhaseClock relaxClock(result.stats, SolverPhase::Relax);)
+
+    // SPFA không có lượt rõ ràng; mỗi vertices lần lấy đỉnh khỏi hàng đợi tính là một lượt
+    long long processed = 0;
+    while (!queue.empty() && !result.hasNegativeCycle) {
+        const int u = queue.front();
+        queue.pop_front();
+        inQueue[u] = 0;
+        if (++processed % vertices == 0
+            && !reportProgress(progress, static_cast<int>(processed / vertices), vertices, distance)) {
+            result.cancelled = true;
+            break;
+        }
+
+        const int du = distance[u];
+        for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+            const int v = csr.targets[k];
+            const long long candidate = static_cast<long long>(du) + csr.weights[k];
+            SOLVER_STATS(++attempted;)
+            if (candidate >= distance[v])
+                continue;
+
+            distance[v] = clampDistance(candidate);
+            previous[v] = u;
+            SOLVER_STATS(++succeeded;)
+            edgesOnPath[v] = edgesOnPath[u] + 1;
+            if (edgesOnPath[v] >= vertices) {
+                result.hasNegativeCycle = true;
+                SOLVER_STATS(PhaseClock checkClock(result.stats, SolverPhase::NegativeCycleCheck);)
+                result.negativeCycle = traceNegativeCycle(previous, v);
+                SOLVER_STATS(checkClock.stop();)
+                break;
+            }
+
+            if (!inQueue[v]) {
+                // SLF: đỉnh có khoảng cách nhỏ hơn đầu hàng đợi được xử lý trước
+                if (!queue.empty() && distance[v] < distance[queue.front()])
+                    queue.push_front(v);
+                else
+                    queue.push_back(v);
+                inQueue[v] = 1;
+                SOLVER_STATS(++pushes;)
+            }
+        }
+    }
+    SOLVER_STATS(relaxClock.stop();
+                 result.stats.passes = (processed + vertices - 1) / vertices;
+                 result.stats.relaxationsAttempted = attempted;
+                 result.stats.relaxationsSucceeded = succeeded;
+                 result.stats.queuePushes = pushes;)
+    // Đỉnh cha có thể đã đổi sau khi edgesOnPath được tính nên hiếm khi cây cha không còn
+    // chứa chu trình; khi đó lấy chu trình từ Bellman-Ford
+    if (result.hasNegativeCycle && result.negativeCycle.empty())
+        result.negativeCycle = bellmanFord(source, true).negativeCycle;
+    resolveOverflow(result);
+    return result;
+}
+
+std::vector<int> GraphEngine::traceNegativeCycle(const int *previous, int witness) const {
+    // Đỉnh được cập nhật ở lượt thứ vertices có chuỗi đỉnh cha dài ít nhất vertices cạnh,
+    // lùi đủ vertices bước thì chắc chắn đang đứng trên một chu trình của cây cha
+    int start = witness;
+    for (int i = 0; i < vertices && start != -1; ++i)
+        start = previous[start];
+
+    std::vector<int> cycle;
+    if (start != -1) {
+        for (int v = start; ; v = previous[v]) {
+            cycle.push_back(v);
+            if (previous[v] == start)
+                break;
+            if (previous[v] == -1 || static_cast<int>(cycle.size()) >= vertices) {
+                cycle.clear();
+                break;
+            }
+        }
+    }
+
+    // Dự phòng: tìm chu trình bất kỳ trong cây cha, mỗi đỉnh được đi qua một lần
+    if (cycle.empty()) {
+        std::vector<char> state(vertices, 0);  // 0: chưa thăm, 1: trên chuỗi đang lần, 2: xong
+        for (int first = 0; first < vertices && cycle.empty(); ++first) {
+            int v = first;
+            while (v != -1 && state[v] == 0) {
+                state[v] = 1;
+                v = previous[v];
+            }
+            if (v != -1 && state[v] == 1) {
+                int u = v;
+                do {
+                    cycle.push_back(u);
+                    u = previous[u];
+                } while (u != v);
+            }
+            for (v = first; v != -1 && state[v] == 1; v = previous[v])
+                state[v] = 2;
+        }
+    }
+
+    // Lần theo previous cho thứ tự ngược chiều cạnh
+    std::reverse(cycle.begin(), cycle.end());
+    return cycle;
+}
+
+int GraphEngine::exactBellmanFord(const std::vector<int> &sources, std::vector<long long> &distance,
+                                  std::vector<int> &previous) const {
+    buildCsr();
+    distance.assign(vertices, LLONG_MAX);
+    previous.assign(vertices, -1);
+    for (int s : sources)
+        distance[s] = 0;
+
+    // Đủ vertices lượt; đỉnh còn được cập nhật ở lượt cuối dẫn ngược về chu trình âm
+    int witness = -1;
+    for (int i = 0; i < vertices; ++i) {
+        witness = -1;
+        for (int u = 0; u < vertices; ++u) {
+            const long long du = distance[u];
+            if (du == LLONG_MAX)
+                continue;
+            for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+                const int v = csr.targets[k];
+                const long long candidate = du + csr.weights[k];
+                // Như các solver int: tổng từ INT_MAX trở lên coi như không tới được
+                if (candidate < distance[v] && candidate < Infinity) {
+                    distance[v] = std::max(candidate, ExactDistanceFloor);
+                    previous[v] = u;
+                    witness = v;
+                }
+            }
+        }
+        if (witness == -1)
+            break;
+    }
+    return witness;
+}
+
+void GraphEngine::resolveOverflow(ShortestPathResult &result) const {
+    if (result.cancelled || result.distance.empty())
+        return;
+    // Chu trình lần được trên cây cha luôn có tổng âm thật, kể cả khi khoảng cách đã bị ghim
+    if (result.hasNegativeCycle && !result.negativeCycle.empty())
+        return;
+    // Không đỉnh nào chạm INT_MIN thì chưa có phép ghim nào và kết quả đã chính xác
+    if (!result.hasNegativeCycle
+        && std::find(result.distance.begin(), result.distance.end(), INT_MIN) == result.distance.end())
+        return;
+
+    // Đỉnh bị ghim ở INT_MIN vẫn "relax được" mãi nên không phân biệt được đường đi quá dài với
+    // chu trình âm; giải lại bằng khoảng cách 64 bit để quyết định
+    SOLVER_STATS(PhaseClock clock(result.stats, SolverPhase::NegativeCycleCheck);)
+    std::vector<long long> exact;
+    const int witness = exactBellmanFord({result.source}, exact, result.previous);
+    result.hasNegativeCycle = witness != -1;
+    result.negativeCycle.clear();
+    if (result.hasNegativeCycle)
+        result.negativeCycle = traceNegativeCycle(result.previous.data(), witness);
+    result.overflowed = false;
+    for (int v = 0; v < vertices; ++v) {
+        result.distance[v] = exact[v] == LLONG_MAX ? Infinity : clampDistance(exact[v]);
+        if (!result.hasNegativeCycle && exact[v] < INT_MIN)
+            result.overflowed = true;
+    }
+    SOLVER_STATS(clock.stop();)
+}
+
+std::vector<int> GraphEngine::unboundedVertices(const ShortestPathResult &result, ShortestPathResult *bounded) const {
+    std::vector<int> unbounded;
+    if (bounded)
+        *bounded = result;
+    if (!result.hasNegativeCycle || result.cancelled || static_cast<int>(result.distance.size()) != vertices)
+        return unbounded;
+    buildCsr();
+
+    // Sau vertices - 1 lượt, đỉnh không bị chu trình âm ảnh hưởng đã có khoảng cách đúng,
+    // nên cạnh còn relax được luôn trỏ tới đỉnh -vô cùng, và mọi chu trình âm tới được
+    // đều có ít nhất một cạnh như vậy. Mọi đỉnh đi tới được từ đó cũng là -vô cùng.
+    // Điều này không đúng với SPFA (dừng ở chu trình đầu tiên, phần còn lại chưa relax xong)
+    // và khi có đỉnh bị ghim ở INT_MIN (cạnh tới đỉnh bị ghim luôn relax được); khi đó lấy
+    // khoảng cách 64 bit từ exactBellmanFord.
+    std::vector<long long> distance;
+    std::vector<int> exactPrevious;
+    const bool exact = result.algorithm == Algorithm::Spfa
+        || std::find(result.distance.begin(), result.distance.end(), INT_MIN) != result.distance.end();
+    if (exact) {
+        SOLVER_STATS(PhaseClock clock(result.stats, SolverPhase::NegativeCycleCheck);)
+        exactBellmanFord({result.source}, distance, exactPrevious);
+    } else {
+        distance.resize(vertices);
+        for (int v = 0; v < vertices; ++v)
+            distance[v] = result.distance[v] == Infinity ? LLONG_MAX : result.distance[v];
+    }
+
+    std::vector<char> marked(vertices, 0);
+    for (int u = 0; u < vertices; ++u) {
+        const long long du = distance[u];
+        if (du == LLONG_MAX)
+            continue;
+        for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+            const int v = csr.targets[k];
+            const long long candidate = du + csr.weights[k];
+            if (!marked[v] && candidate < distance[v] && candidate < Infinity) {
+                marked[v] = 1;
+                unbounded.push_back(v);
+            }
+        }
+    }
+    for (size_t head = 0; head < unbounded.size(); ++head) {
+        const int u = unbounded[head];
+        for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+            const int v = csr.targets[k];
+            if (!marked[v]) {
+                marked[v] = 1;
+                unbounded.push_back(v);
+            }
+        }
+    }
+
+    // Đỉnh cha của đỉnh không -vô cùng cũng không -vô cùng (nếu không thì nó tới được từ chu trình),
+    // nên cây đường đi tới các đỉnh này vẫn dùng được
+    if (bounded) {
+        bounded->hasNegativeCycle = false;
+        bounded->negativeCycle.clear();
+        bounded->overflowed = false;
+        for (int v = 0; v < vertices; ++v) {
+            if (marked[v] || distance[v] == LLONG_MAX) {
+                bounded->distance[v] = Infinity;
+                bounded->previous[v] = -1;
+                continue;
+            }
+            bounded->distance[v] = clampDistance(distance[v]);
+            if (exact)
+                bounded->previous[v] = exactPrevious[v];
+            if (distance[v] < INT_MIN)
+                bounded->overflowed = true;
+        }
+    }
+    return unbounded;
+}
+
+bool GraphEngine::buildPotential(const ProgressCallback &progress, bool *cancelled, SolverStats *stats) const {
+    if (potentialRevision == revision)
+        return !potentialHasNegativeCycle;
+    buildCsr();
+
+    // Bộ đếm ghi vào lần giải đã yêu cầu thế năng, nếu có
+    (void)stats;  // Không dùng khi tắt FORDBELLMAN_STATS
+    SOLVER_STATS(SolverStats unused;
+                 SolverStats &counters = stats ? *stats : unused;
+                 PhaseClock clock(counters, SolverPhase::Potential);
+                 long long attempted = 0, succeeded = 0;)
+
+    // Bellman-Ford từ một đỉnh nguồn ảo nối tới mọi đỉnh bằng cạnh trọng số 0
+    potential.assign(vertices, 0);
+    bool changed = true;
+    for (int i = 0; i < vertices && changed; ++i) {
+        changed = false;
+        SOLVER_STATS(++counters.passes;)
+        for (int u = 0; u < vertices; ++u) {
+            const long long hu = potential[u];
+            for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+                const long long candidate = hu + csr.weights[k];
+                SOLVER_STATS(++attempted;)
+                // Ghim xa như exactBellmanFord: chỉ chu trình âm chạm được mức này
+                if (candidate < potential[csr.targets[k]]) {
+                    potential[csr.targets[k]] = std::max(candidate, ExactDistanceFloor);
+                    changed = true;
+                    SOLVER_STATS(++succeeded;)
+                }
+            }
+        }
+        // Dừng giữa chừng thì không lưu thế năng dở dang
+        if (changed && !reportProgress(progress, i + 1, vertices, nullptr)) {
+            *cancelled = true;
+            break;
+        }
+    }
+    SOLVER_STATS(clock.stop();
+                 counters.relaxationsAttempted += attempted;
+                 counters.relaxationsSucceeded += succeeded;)
+    if (*cancelled)
+        return false;
+
+    // Sau vertices lượt vẫn còn cập nhật được thì có chu trình âm
+    potentialHasNegativeCycle = changed;
+    potentialRevision = revision;
+    return !potentialHasNegativeCycle;
+}
+
+void GraphEngine::runDijkstra(ShortestPathResult &result, const long long *potential,
+                              const ProgressCallback &progress) const {
+    const int source = result.source;
+    int *previous = result.previous.data();
+
+    // Khoảng cách theo trọng số đã đổi w + h[u] - h[v] (không âm)
+    std::vector<long long> reduced(vertices, LLONG_MAX);
+    std::vector<char> settled(vertices, 0);
+    using Entry = std::pair<long long, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    reduced[source] = 0;
+    heap.push({0, source});
+    int settledCount = 0;
+    SOLVER_STATS(long long attempted = 0, succeeded = 0;)
+    SOLVER_STATS(PhaseClock relaxClock(result.stats, SolverPhase::Relax);)
+
+    while (!heap.empty()) {
+        const Entry top = heap.top();
+        heap.pop();
+        const int u = top.second;
+        if (settled[u])
+            continue;
+        settled[u] = 1;
+
+        // Đổi về khoảng cách thật ngay khi chốt để tiến độ thấy được các đỉnh đã xong
+        long long d = top.first;
+        if (potential)
+            d += potential[u] - potential[source];
+        // Như Bellman-Ford: khoảng cách vượt INT_MAX coi như không tới được và không đi tiếp từ đó
+        const bool representable = d < Infinity;
+        result.distance[u] = representable ? clampDistance(d) : Infinity;
+        if (d < INT_MIN)
+            result.overflowed = true;
+        if (!representable)
+            previous[u] = -1;
+        if (++settledCount % DijkstraProgressInterval == 0
+            && !reportProgress(progress, settledCount, vertices, result.distance.data())) {
+            result.cancelled = true;
+            break;
+        }
+        if (!representable)
+            continue;
+
+        for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+            const int v = csr.targets[k];
+            long long weight = csr.weights[k];
+            if (potential)
+                weight += potential[u] - potential[v];
+            const long long candidate = top.first + weight;
+            SOLVER_STATS(++attempted;)
+            if (candidate < reduced[v]) {
+                reduced[v] = candidate;
+                previous[v] = u;
+                heap.push({candidate, v});
+                SOLVER_STATS(++succeeded;)
+            }
+        }
+    }
+    SOLVER_STATS(relaxClock.stop();
+                 ++result.stats.passes;
+                 result.stats.relaxationsAttempted += attempted;
+                 result.stats.relaxationsSucceeded += succeeded;
+                 result.stats.queuePushes += succeeded + 1;)
+}
+
+ShortestPathResult GraphEngine::dijkstra(int source, const ProgressCallback &progress) const {
+    buildCsr();
+
+    ShortestPathResult result = initResult(source);
+    result.algorithm = Algorithm::Dijkstra;
+    if (source >= 0 && source < vertices)
+        runDijkstra(result, nullptr, progress);
+    return result;
+}
+
+ShortestPathResult GraphEngine::johnson(int source, const ProgressCallback &progress) const {
+    ShortestPathResult result = initResult(source);
+    result.algorithm = Algorithm::Johnson;
+    if (source < 0 || source >= vertices)
+        return result;
+
+    bool cancelled = false;
+    if (!buildPotential(progress, &cancelled, &result.stats)) {
+        if (cancelled) {
+            result.cancelled = true;
+            return result;
+        }
+        result.distance.clear();
+        result.previous.clear();
+        return result;
+    }
+    runDijkstra(result, potential.data(), progress);
+    return result;
+}
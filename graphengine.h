@@ -0,0 +1,201 @@
+#ifndef GRAPHENGINE_H
+#define GRAPHENGINE_H
+
+#include "solverstats.h"
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Chế độ giải bài toán đường đi ngắn nhất
+enum class SolverMode {
+    Auto,          // Dijkstra nếu không có cạnh âm, ngược lại Johnson
+    BellmanFord,   // Luôn chạy đủ vertices - 1 lượt
+    EarlyExit,     // Dừng khi một lượt không cập nhật được đỉnh nào
+    Spfa,          // Hàng đợi hai đầu (SLF), chỉ relax cạnh ra của đỉnh vừa thay đổi
+    Parallel,      // Bellman-Ford theo frontier trên nhiều luồng
+    Vectorized     // Bellman-Ford quét mảng cạnh SoA bằng nhân SIMD
+};
+
+// Tiến độ của một lần giải, gửi sau mỗi lượt relax
+struct SolverProgress {
+    int round = 0;        // Số lượt đã xong (Dijkstra: số đỉnh đã chốt)
+    int totalRounds = 0;  // Giới hạn trên của round, dùng để tính phần trăm
+    // Khoảng cách tạm thời của từng đỉnh, chỉ đọc được trong lúc gọi; nullptr ở pha
+    // không có khoảng cách từ nguồn (thế năng Johnson, Floyd-Warshall)
+    const int *distance = nullptr;
+};
+
+// Được gọi trên luồng đang giải; trả về false để dừng giữa chừng
+using ProgressCallback = std::function<bool(const SolverProgress &)>;
+
+struct SolverOptions {
+    SolverMode mode = SolverMode::Auto;
+    int threadCount = 0;  // Số luồng cho chế độ Parallel, 0 = theo số nhân CPU
+    ProgressCallback progress;  // Không đặt thì không tốn gì thêm
+};
+
+// Thuật toán thực sự đã chạy để cho ra kết quả
+enum class Algorithm {
+    BellmanFord,
+    Spfa,
+    Dijkstra,
+    Johnson,
+    ParallelBellmanFord,
+    VectorizedBellmanFord
+};
+
+const char *algorithmName(Algorithm algorithm);
+
+// Kết quả của một lần tìm đường đi ngắn nhất từ một đỉnh nguồn
+struct ShortestPathResult {
+    int source = -1;
+    Algorithm algorithm = Algorithm::BellmanFord;
+    std::vector<int> distance;  // Khoảng cách từ nguồn, INT_MAX nếu không tới được
+    std::vector<int> previous;  // Đỉnh đi trước trên cây đường đi, -1 nếu không có
+    bool hasNegativeCycle = false;
+    // Khi hasNegativeCycle: các đỉnh của một chu trình âm tới được từ nguồn, theo chiều cạnh
+    // (cạnh cuối quay về đỉnh đầu). Johnson không tìm chu trình nên để rỗng.
+    std::vector<int> negativeCycle;
+    // Không có chu trình âm nhưng có đường đi ngắn nhất tổng nhỏ hơn INT_MIN; khoảng cách của
+    // các đỉnh đó được ghim ở INT_MIN
+    bool overflowed = false;
+    bool cancelled = false;  // Bị dừng qua ProgressCallback, distance chưa phải kết quả cuối
+    // Bộ đếm và thời gian từng pha; pathTo() ghi thêm pha dựng đường đi nên để mutable
+    mutable SolverStats stats;
+
+    bool reachable(int target) const;
+    std::vector<int> pathTo(int target) const;  // Rỗng nếu không có đường đi
+};
+
+// Các mảng CSR chỉ đọc, có thể nằm ngoài GraphEngine (ví dụ trong file ánh xạ bộ nhớ).
+// owner giữ vùng nhớ sống chừng nào GraphEngine còn dùng.
+struct CsrView {
+    int vertexCount = 0;
+    int edgeCount = 0;
+    const int *offsets = nullptr;  // vertexCount + 1 phần tử
+    const int *sources = nullptr;  // Các mảng cạnh dưới đây sắp theo đỉnh nguồn
+    const int *targets = nullptr;
+    const int *weights = nullptr;
+    std::shared_ptr<const void> owner;
+};
+
+// Đồ thị có hướng dùng đỉnh là số nguyên 0..n-1, lưu dạng CSR
+// (compressed sparse row) để vòng lặp relax chỉ quét mảng liên tục.
+// Không phụ thuộc Qt nên có thể chạy và đo hiệu năng không cần QApplication.
+class GraphEngine
+{
+public:
+    static constexpr int Infinity = INT_MAX;
+
+    // Khoảng cách nhỏ hơn INT_MIN không biểu diễn được, chỉ gặp khi có chu trình âm (hoặc đường đi
+    // âm vượt phạm vi int). Ghim ở INT_MIN thay vì để tràn số; phép relax so sánh bằng long long
+    // nên cạnh đưa khoảng cách xuống dưới mức này vẫn được tính là cập nhật và chu trình vẫn bị phát hiện.
+    // Đường đi không có chu trình bị ghim cũng "relax được" mãi, nên khi kết quả còn đỉnh ở INT_MIN mà
+    // chưa lần ra chu trình thì solver giải lại bằng khoảng cách 64 bit và báo qua overflowed.
+    static int clampDistance(long long distance) {
+        return distance < INT_MIN ? INT_MIN : static_cast<int>(distance);
+    }
+
+    GraphEngine() = default;
+    // csr trỏ vào bộ nhớ của chính đối tượng nên không cho sao chép, chỉ cho di chuyển
+    GraphEngine(const GraphEngine &) = delete;
+    GraphEngine &operator=(const GraphEngine &) = delete;
+    GraphEngine(GraphEngine &&) = default;
+    GraphEngine &operator=(GraphEngine &&) = default;
+
+    void clear();
+    int addVertex();
+    int addEdge(int from, int to, int weight);  // Trả về chỉ số cạnh
+    void setEdgeWeight(int edge, int weight);
+    void reserveEdges(int count);
+
+    // Dùng trực tiếp mảng CSR bên ngoài, không sao chép. Cạnh thứ i là vị trí i trong CSR.
+    // Lần sửa đồ thị đầu tiên sau đó sẽ chép dữ liệu về bộ nhớ riêng.
+    void attach(const CsrView &view);
+    bool isAttached() const { return external; }
+    CsrView csrView() const;  // Chỉ hợp lệ tới lần sửa đồ thị tiếp theo
+
+    int vertexCount() const { return vertices; }
+    int edgeCount() const { return external ? csr.edgeCount : static_cast<int>(edgeTo.size()); }
+    int edgeSource(int edge) const { return external ? csr.sources[edge] : edgeFrom[edge]; }
+    int edgeTarget(int edge) const { return external ? csr.targets[edge] : edgeTo[edge]; }
+    int edgeWeight(int edge) const { return external ? csr.weights[edge] : edgeWeights[edge]; }
+    int negativeEdgeCount() const { return negativeEdges; }
+    std::uint64_t generation() const { return revision; }  // Tăng mỗi khi đồ thị thay đổi
+
+    // Dựng sẵn CSR và thế năng Johnson. Sau đó các hàm giải dưới đây chỉ đọc dữ liệu của
+    // đồ thị nên gọi được từ nhiều luồng cùng lúc (miễn là đồ thị không bị sửa), trừ
+    // findNegativeCycle() vì nó ghi bộ nhớ đệm chu trình.
+    void prepareSolvers() const;
+
+    ShortestPathResult shortestPaths(int source, const SolverOptions &options = SolverOptions()) const;
+    ShortestPathResult bellmanFord(int source, bool earlyExit = true,
+                                   const ProgressCallback &progress = nullptr) const;
+    ShortestPathResult spfa(int source, const ProgressCallback &progress = nullptr) const;
+    ShortestPathResult dijkstra(int source, const ProgressCallback &progress = nullptr) const;
+    // Rỗng distance nếu có chu trình âm
+    ShortestPathResult johnson(int source, const ProgressCallback &progress = nullptr) const;
+    ShortestPathResult parallelBellmanFord(int source, int threadCount = 0,
+                                           const ProgressCallback &progress = nullptr) const;
+    ShortestPathResult vectorizedBellmanFord(int source, const ProgressCallback &progress = nullptr) const;
+
+    // Tìm một chu trình âm bất kỳ trên toàn đồ thị, kể cả phần không tới được từ nguồn nào:
+    // Bellman-Ford song song từ một đỉnh nguồn ảo nối tới mọi đỉnh. Rỗng nếu không có hoặc bị dừng.
+    // threadCount = 0: một luồng với đồ thị nhỏ, ngược lại theo số nhân CPU.
+    // Kết quả được nhớ theo generation(), và bỏ qua luôn khi thế năng Johnson đã chứng minh
+    // đồ thị không có chu trình âm. Không gọi đồng thời từ nhiều luồng.
+    std::vector<int> findNegativeCycle(int threadCount = 0, const ProgressCallback &progress = nullptr,
+                                       bool *cancelled = nullptr) const;
+    // Các đỉnh có khoảng cách -vô cùng từ nguồn của result (tới được từ một chu trình âm),
+    // tìm bằng một lượt relax kiểm tra cộng một lần BFS. Kết quả SPFA (dừng ngay ở chu trình
+    // đầu tiên) hoặc có đỉnh bị ghim ở INT_MIN thì phải giải lại Bellman-Ford 64 bit trước.
+    // bounded (nếu khác nullptr) nhận kết quả chỉ gồm các đỉnh còn lại: khoảng cách và cây đường đi
+    // đúng, đỉnh -vô cùng coi như không tới được, không còn cờ chu trình âm.
+    std::vector<int> unboundedVertices(const ShortestPathResult &result, ShortestPathResult *bounded = nullptr) const;
+
+private:
+    void detach();
+    void buildCsr() const;
+    bool buildPotential(const ProgressCallback &progress, bool *cancelled, SolverStats *stats) const;
+    ShortestPathResult initResult(int source) const;
+    void runDijkstra(ShortestPathResult &result, const long long *potential, const ProgressCallback &progress) const;
+    void buildPredecessorTree(ShortestPathResult &result) const;
+    std::vector<int> traceNegativeCycle(const int *previous, int witness) const;
+    int exactBellmanFord(const std::vector<int> &sources, std::vector<long long> &distance,
+                         std::vector<int> &previous) const;
+    void resolveOverflow(ShortestPathResult &result) const;
+
+    int vertices = 0;
+    int negativeEdges = 0;
+    std::uint64_t revision = 0;
+
+    // Danh sách cạnh theo thứ tự thêm vào
+    std::vector<int> edgeFrom;
+    std::vector<int> edgeTo;
+    std::vector<int> edgeWeights;
+
+    // Dạng CSR, dựng lại khi đồ thị thay đổi cấu trúc.
+    // csr trỏ vào các vector dưới đây hoặc vào vùng nhớ ngoài khi external.
+    bool external = false;
+    mutable CsrView csr;
+    mutable bool csrDirty = true;
+    mutable std::vector<int> rowOffsets;    // vertices + 1 phần tử
+    mutable std::vector<int> csrSources;    // Cùng csrTargets/csrWeights tạo thành mảng cạnh SoA
+    mutable std::vector<int> csrTargets;
+    mutable std::vector<int> csrWeights;
+    mutable std::vector<int> edgeSlot;      // chỉ số cạnh -> vị trí trong CSR
+
+    // Thế năng Johnson (khoảng cách từ đỉnh nguồn ảo), dùng lại giữa các truy vấn. Lưu 64 bit vì
+    // thế năng có thể nhỏ hơn INT_MIN mà đồ thị vẫn không có chu trình âm.
+    mutable std::vector<long long> potential;
+    mutable std::uint64_t potentialRevision = UINT64_MAX;
+    mutable bool potentialHasNegativeCycle = false;
+
+    // Chu trình âm toàn đồ thị do findNegativeCycle() tìm được ở lần chạy trọn gần nhất
+    mutable std::vector<int> graphCycle;
+    mutable std::uint64_t graphCycleRevision = UINT64_MAX;
+};
+
+#endif // GRAPHENGINE_H
@@ -0,0 +1,509 @@
+#include "graphio.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Đầu file nhị phân, theo sau là offsets[n + 1], sources[m], targets[m], weights[m]
+// và nếu có cờ HasPositions thì thêm 2n số float tọa độ.
+struct BinaryHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::int32_t vertexCount;
+    std::int32_t edgeCount;
+    std::uint64_t reserved;
+};
+
+const char BinaryMagic[8] = { 'F', 'B', 'C', 'S', 'R', 0, 0, 0 };
+const std::uint32_t BinaryVersion = 1;
+const std::uint32_t HasPositions = 1;
+
+// File chỉ đọc được ánh xạ vào bộ nhớ, giải phóng khi hủy
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data)
+            UnmapViewOfFile(data);
+        if (mapping)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+#else
+        if (data)
+            munmap(const_cast<char *>(data), size);
+#endif
+    }
+
+    bool open(const std::string &path, std::string *error) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        LARGE_INTEGER fileSize;
+        if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize)) {
+            *error = "Không mở được file " + path;
+            return false;
+        }
+        size = static_cast<size_t>(fileSize.QuadPart);
+        if (size == 0)
+            return true;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping)
+            data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0) {
+            if (fd >= 0)
+                ::close(fd);
+            *error = "Không mở được file " + path;
+            return false;
+        }
+        size = static_cast<size_t>(info.st_size);
+        if (size == 0) {
+            ::close(fd);
+            return true;
+        }
+        void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (address != MAP_FAILED)
+            data = static_cast<const char *>(address);
+#endif
+        if (!data) {
+            *error = "Không ánh xạ được file " + path + " vào bộ nhớ";
+            return false;
+        }
+        return true;
+    }
+
+    const char *data = nullptr;
+    size_t size = 0;
+
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+bool readFile(const std::string &path, std::string &contents, std::string *error) {
+    FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        *error = "Không mở được file " + path;
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        // Ống hoặc /dev/stdin không biết trước kích thước, đọc từng khối tới hết
+        char buffer[1 << 16];
+        size_t chunk;
+        contents.clear();
+        while ((chunk = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+            contents.append(buffer, chunk);
+        bool failed = std::ferror(file) != 0;
+        std::fclose(file);
+        if (failed) {
+            *error = "Không đọc được file " + path;
+            return false;
+        }
+        return true;
+    }
+    contents.resize(static_cast<size_t>(size));
+    size_t read = contents.empty() ? 0 : std::fread(&contents[0], 1, contents.size(), file);
+    std::fclose(file);
+    if (read != contents.size()) {
+        *error = "Không đọc được file " + path;
+        return false;
+    }
+    return true;
+}
+
+// Đọc một số nguyên sau các khoảng trắng, dịch con trỏ qua số vừa đọc
+bool parseInt(const char *&cursor, long long &value) {
+    while (*cursor == ' ' || *cursor == '\t')
+        ++cursor;
+    // strtoll tự bỏ qua xuống dòng, nên chặn trước để không đọc sang dòng sau
+    if (*cursor != '-' && *cursor != '+' && (*cursor < '0' || *cursor > '9'))
+        return false;
+    char *end;
+    errno = 0;
+    value = std::strtoll(cursor, &end, 10);
+    if (end == cursor || errno == ERANGE)
+        return false;
+    cursor = end;
+    return true;
+}
+
+bool lineError(std::string *error, int line, const char *message) {
+    *error = "Dòng " + std::to_string(line) + ": " + message;
+    return false;
+}
+
+// Nạp danh sách cạnh đã đọc vào đồ thị
+void fillGraph(GraphEngine &graph, int vertexCount, const std::vector<int> &edges) {
+    graph.clear();
+    graph.reserveEdges(static_cast<int>(edges.size() / 3));
+    for (int v = 0; v < vertexCount; ++v)
+        graph.addVertex();
+    for (size_t i = 0; i < edges.size(); i += 3)
+        graph.addEdge(edges[i], edges[i + 1], edges[i + 2]);
+}
+
+bool writeAll(FILE *file, const void *data, size_t bytes) {
+    return bytes == 0 || std::fwrite(data, 1, bytes, file) == bytes;
+}
+
+} // namespace
+
+GraphFormat graphFormatFromPath(const std::string &path) {
+    auto endsWith = [&](const char *suffix) {
+        const size_t length = std::strlen(suffix);
+        if (path.size() < length)
+            return false;
+        for (size_t i = 0; i < length; ++i) {
+            char c = path[path.size() - length + i];
+            if (c >= 'A' && c <= 'Z')
+                c = static_cast<char>(c - 'A' + 'a');
+            if (c != suffix[i])
+                return false;
+        }
+        return true;
+    };
+    if (endsWith(".gr"))
+        return GraphFormat::Dimacs;
+    if (endsWith(".csv"))
+        return GraphFormat::Csv;
+    return GraphFormat::Binary;
+}
+
+bool loadGraph(const std::string &path, GraphEngine &graph, std::vector<float> *positions, std::string *error) {
+    if (positions)
+        positions->clear();
+    switch (graphFormatFromPath(path)) {
+    case GraphFormat::Dimacs:
+        return loadDimacs(path, graph, error);
+    case GraphFormat::Csv:
+        return loadCsv(path, graph, error);
+    case GraphFormat::Binary:
+        return loadBinary(path, graph, positions, error);
+    }
+    return false;
+}
+
+bool saveGraph(const std::string &path, const GraphEngine &graph, const std::vector<float> *positions, std::string *error) {
+    switch (graphFormatFromPath(path)) {
+    case GraphFormat::Dimacs:
+        return saveDimacs(path, graph, error);
+    case GraphFormat::Csv:
+        return saveCsv(path, graph, error);
+    case GraphFormat::Binary:
+        return saveBinary(path, graph, positions, error);
+    }
+    return false;
+}
+
+bool loadDimacs(const std::string &path, GraphEngine &graph, std::string *error) {
+    std::string contents;
+    if (!readFile(path, contents, error))
+        return false;
+
+    long long vertexCount = -1;
+    std::vector<int> edges;
+    int line = 0;
+    for (const char *cursor = contents.c_str(); *cursor; ) {
+        const char *lineEnd = std::strchr(cursor, '\n');
+        if (!lineEnd)
+            lineEnd = cursor + std::strlen(cursor);
+        ++line;
+
+        if (*cursor == 'p') {
+            // p sp <số đỉnh> <số cạnh>
+            long long edgeCount;
+            cursor = std::strstr(cursor, "sp");
+            if (!cursor || cursor > lineEnd)
+                return lineError(error, line, "dòng p phải có dạng \"p sp <n> <m>\"");
+            cursor += 2;
+            if (!parseInt(cursor, vertexCount) || !parseInt(cursor, edgeCount)
+                || vertexCount < 0 || vertexCount > INT_MAX - 1 || edgeCount < 0 || edgeCount > INT_MAX)
+                return lineError(error, line, "số đỉnh hoặc số cạnh không hợp lệ");
+            edges.reserve(static_cast<size_t>(edgeCount) * 3);
+        } else if (*cursor == 'a') {
+            ++cursor;
+            long long from, to, weight;
+            if (vertexCount < 0)
+                return lineError(error, line, "cạnh xuất hiện trước dòng p");
+            if (!parseInt(cursor, from) || !parseInt(cursor, to) || !parseInt(cursor, weight))
+                return lineError(error, line, "cạnh phải có dạng \"a <u> <v> <w>\"");
+            if (from < 1 || from > vertexCount || to < 1 || to > vertexCount)
+                return lineError(error, line, "đỉnh nằm ngoài khoảng 1..n");
+            if (weight < INT_MIN || weight > INT_MAX)
+                return lineError(error, line, "trọng số vượt quá giới hạn");
+            edges.push_back(static_cast<int>(from - 1));
+            edges.push_back(static_cast<int>(to - 1));
+            edges.push_back(static_cast<int>(weight));
+        }
+        // Các dòng khác (c, trống) được bỏ qua
+        cursor = *lineEnd ? lineEnd + 1 : lineEnd;
+    }
+
+    if (vertexCount < 0) {
+        *error = "Thiếu dòng \"p sp <n> <m>\"";
+        return false;
+    }
+    fillGraph(graph, static_cast<int>(vertexCount), edges);
+    return true;
+}
+
+bool loadCsv(const std::string &path, GraphEngine &graph, std::string *error) {
+    std::string contents;
+    if (!readFile(path, contents, error))
+        return false;
+
+    long long vertexCount = 0;
+    std::vector<int> edges;
+    int line = 0;
+    bool firstLine = true;
+    for (const char *cursor = contents.c_str(); *cursor; ) {
+        const char *lineEnd = std::strchr(cursor, '\n');
+        if (!lineEnd)
+            lineEnd = cursor + std::strlen(cursor);
+        ++line;
+
+        const char *start = cursor;
+        while (start < lineEnd && (*start == ' ' || *start == '\t' || *start == '\r'))
+            ++start;
+        const bool numeric = start < lineEnd && (*start == '-' || (*start >= '0' && *start <= '9'));
+        // Bỏ qua dòng trống, chú thích # và dòng tiêu đề đầu tiên
+        if (start < lineEnd && *start != '#' && (numeric || !firstLine)) {
+            long long values[3];
+            cursor = start;
+            for (int i = 0; i < 3; ++i) {
+                if (i > 0) {
+                    while (*cursor == ' ' || *cursor == '\t')
+                        ++cursor;
+                    if (*cursor != ',' && *cursor != ';')
+                        return lineError(error, line, "cần dạng \"<từ>,<đến>,<trọng số>\"");
+                    ++cursor;
+                }
+                if (!parseInt(cursor, values[i]))
+                    return lineError(error, line, "cần dạng \"<từ>,<đến>,<trọng số>\"");
+            }
+            if (values[0] < 0 || values[0] >= INT_MAX || values[1] < 0 || values[1] >= INT_MAX)
+                return lineError(error, line, "chỉ số đỉnh không hợp lệ");
+            if (values[2] < INT_MIN || values[2] > INT_MAX)
+                return lineError(error, line, "trọng số vượt quá giới hạn");
+            edges.push_back(static_cast<int>(values[0]));
+            edges.push_back(static_cast<int>(values[1]));
+            edges.push_back(static_cast<int>(values[2]));
+            vertexCount = std::max(vertexCount, std::max(values[0], values[1]) + 1);
+        }
+        if (start < lineEnd)
+            firstLine = false;
+        cursor = *lineEnd ? lineEnd + 1 : lineEnd;
+    }
+
+    fillGraph(graph, static_cast<int>(vertexCount), edges);
+    return true;
+}
+
+bool loadBinary(const std::string &path, GraphEngine &graph, std::vector<float> *positions, std::string *error) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path, error))
+        return false;
+
+    BinaryHeader header;
+    if (file->size < sizeof(header)) {
+        *error = "File nhị phân quá ngắn";
+        return false;
+    }
+    std::memcpy(&header, file->data, sizeof(header));
+    if (std::memcmp(header.magic, BinaryMagic, sizeof(BinaryMagic)) != 0 || header.version != BinaryVersion) {
+        *error = "Không phải file đồ thị nhị phân hoặc sai phiên bản";
+        return false;
+    }
+
+    const long long n = header.vertexCount;
+    const long long m = header.edgeCount;
+    const bool hasPositions = header.flags & HasPositions;
+    if (n < 0 || m < 0 || n == INT_MAX) {
+        *error = "Số đỉnh hoặc số cạnh không hợp lệ";
+        return false;
+    }
+    const size_t expected = sizeof(header) + sizeof(std::int32_t) * static_cast<size_t>(n + 1 + 3 * m)
+                            + (hasPositions ? sizeof(float) * static_cast<size_t>(2 * n) : 0);
+    if (file->size != expected) {
+        *error = "Kích thước file nhị phân không khớp với phần đầu";
+        return false;
+    }
+
+    CsrView view;
+    view.vertexCount = static_cast<int>(n);
+    view.edgeCount = static_cast<int>(m);
+    view.offsets = reinterpret_cast<const int *>(file->data + sizeof(header));
+    view.sources = view.offsets + n + 1;
+    view.targets = view.sources + m;
+    view.weights = view.targets + m;
+
+    // Kiểm tra cấu trúc CSR một lần để solver không đọc ra ngoài mảng. Offsets phải đúng hết
+    // trước khi dùng làm cận vòng lặp duyệt cạnh
+    if (view.offsets[0] != 0 || view.offsets[n] != m) {
+        *error = "Mảng offsets không hợp lệ";
+        return false;
+    }
+    for (int u = 0; u < view.vertexCount; ++u) {
+        if (view.offsets[u + 1] > m) {
+            *error = "Mảng offsets không hợp lệ";
+            return false;
+        }
+        if (view.offsets[u] > view.offsets[u + 1]) {
+            *error = "Mảng offsets không tăng dần";
+            return false;
+        }
+    }
+    for (int u = 0; u < view.vertexCount; ++u) {
+        for (int k = view.offsets[u]; k < view.offsets[u + 1]; ++k) {
+            if (view.sources[k] != u || view.targets[k] < 0 || view.targets[k] >= view.vertexCount) {
+                *error = "Cạnh thứ " + std::to_string(k) + " không hợp lệ";
+                return false;
+            }
+        }
+    }
+
+    if (positions && hasPositions) {
+        const float *coordinates = reinterpret_cast<const float *>(view.weights + m);
+        positions->assign(coordinates, coordinates + 2 * n);
+    }
+    view.owner = file;
+    graph.attach(view);
+    return true;
+}
+
+bool saveDimacs(const std::string &path, const GraphEngine &graph, std::string *error) {
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        *error = "Không ghi được file " + path;
+        return false;
+    }
+    std::fprintf(file, "c Đồ thị xuất từ fordbellman\np sp %d %d\n", graph.vertexCount(), graph.edgeCount());
+    for (int e = 0; e < graph.edgeCount(); ++e)
+        std::fprintf(file, "a %d %d %d\n", graph.edgeSource(e) + 1, graph.edgeTarget(e) + 1, graph.edgeWeight(e));
+    const bool ok = std::ferror(file) == 0;
+    if (std::fclose(file) != 0 || !ok) {
+        *error = "Không ghi được file " + path;
+        return false;
+    }
+    return true;
+}
+
+bool saveCsv(const std::string &path, const GraphEngine &graph, std::string *error) {
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        *error = "Không ghi được file " + path;
+        return false;
+    }
+    std::fprintf(file, "from,to,weight\n");
+    for (int e = 0; e < graph.edgeCount(); ++e)
+        std::fprintf(file, "%d,%d,%d\n", graph.edgeSource(e), graph.edgeTarget(e), graph.edgeWeight(e));
+    const bool ok = std::ferror(file) == 0;
+    if (std::fclose(file) != 0 || !ok) {
+        *error = "Không ghi được file " + path;
+        return false;
+    }
+    return true;
+}
+
+bool saveBinary(const std::string &path, const GraphEngine &graph, const std::vector<float> *positions, std::string *error) {
+    const CsrView view = graph.csrView();
+    const size_t n = static_cast<size_t>(view.vertexCount);
+    const size_t m = static_cast<size_t>(view.edgeCount);
+    const bool hasPositions = positions && positions->size() == 2 * n;
+
+    BinaryHeader header;
+    std::memcpy(header.magic, BinaryMagic, sizeof(BinaryMagic));
+    header.version = BinaryVersion;
+    header.flags = hasPositions ? HasPositions : 0;
+    header.vertexCount = view.vertexCount;
+    header.edgeCount = view.edgeCount;
+    header.reserved = 0;
+
+    // Đồ thị rỗng chưa có mảng offsets
+    const int emptyOffsets = 0;
+    const int *offsets = view.offsets ? view.offsets : &emptyOffsets;
+
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        *error = "Không ghi được file " + path;
+        return false;
+    }
+    bool ok = writeAll(file, &header, sizeof(header))
+              && writeAll(file, offsets, sizeof(int) * (n + 1))
+              && writeAll(file, view.sources, sizeof(int) * m)
+              && writeAll(file, view.targets, sizeof(int) * m)
+              && writeAll(file, view.weights, sizeof(int) * m)
+              && (!hasPositions || writeAll(file, positions->data(), sizeof(float) * 2 * n));
+    if (std::fclose(file) != 0 || !ok) {
+        *error = "Không ghi được file " + path;
+        return false;
+    }
+    return true;
+}
+
+bool loadQueries(const std::string &path, std::vector<PathQuery> &queries, int firstVertex, int vertexCount,
+                 std::string *error) {
+    std::string contents;
+    if (!readFile(path, contents, error))
+        return false;
+
+    queries.clear();
+    int line = 0;
+    for (const char *cursor = contents.c_str(); *cursor; ) {
+        const char *lineEnd = std::strchr(cursor, '\n');
+        if (!lineEnd)
+            lineEnd = cursor + std::strlen(cursor);
+        ++line;
+
+        while (*cursor == ' ' || *cursor == '\t')
+            ++cursor;
+        if (*cursor == 'q')
+            ++cursor;
+        if (cursor != lineEnd && *cursor != '\r' && *cursor != 'c' && *cursor != '#') {
+            long long source, target;
+            if (!parseInt(cursor, source) || !parseInt(cursor, target))
+                return lineError(error, line, "truy vấn phải có dạng \"<nguồn> <đích>\"");
+            source -= firstVertex;
+            target -= firstVertex;
+            if (source < 0 || source >= vertexCount || target < 0 || target >= vertexCount) {
+                return lineError(error, line, firstVertex == 1 ? "đỉnh nằm ngoài khoảng 1..n"
+                                                               : "đỉnh nằm ngoài khoảng 0..n-1");
+            }
+            PathQuery query;
+            query.source = static_cast<int>(source);
+            query.target = static_cast<int>(target);
+            queries.push_back(query);
+        }
+        cursor = *lineEnd ? lineEnd + 1 : lineEnd;
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef GRAPHIO_H
+#define GRAPHIO_H
+
+#include "batchquery.h"
+#include "graphengine.h"
+#include <string>
+#include <vector>
+
+// Định dạng file đồ thị, chọn theo phần mở rộng
+enum class GraphFormat {
+    Dimacs,  // .gr: "p sp <n> <m>" và "a <u> <v> <w>", đỉnh đánh số từ 1
+    Csv,     // .csv: mỗi dòng "<từ>,<đến>,<trọng số>", đỉnh đánh số từ 0
+    Binary   // .fbg: CSR nhị phân, được ánh xạ bộ nhớ và dùng trực tiếp
+};
+
+GraphFormat graphFormatFromPath(const std::string &path);
+
+// positions (nếu khác nullptr) nhận/ghi tọa độ x, y của từng đỉnh liên tiếp nhau.
+// Chỉ định dạng nhị phân lưu tọa độ; với định dạng khác positions được trả về rỗng.
+// Khi lỗi trả về false và ghi lý do vào error.
+bool loadGraph(const std::string &path, GraphEngine &graph, std::vector<float> *positions, std::string *error);
+bool saveGraph(const std::string &path, const GraphEngine &graph, const std::vector<float> *positions, std::string *error);
+
+bool loadDimacs(const std::string &path, GraphEngine &graph, std::string *error);
+bool loadCsv(const std::string &path, GraphEngine &graph, std::string *error);
+bool loadBinary(const std::string &path, GraphEngine &graph, std::vector<float> *positions, std::string *error);
+
+bool saveDimacs(const std::string &path, const GraphEngine &graph, std::string *error);
+bool saveCsv(const std::string &path, const GraphEngine &graph, std::string *error);
+bool saveBinary(const std::string &path, const GraphEngine &graph, const std::vector<float> *positions, std::string *error);
+
+// File truy vấn: mỗi dòng "<nguồn> <đích>", có thể mở đầu bằng "q" như file truy vấn DIMACS.
+// Dòng trống và dòng bắt đầu bằng 'c' hoặc '#' bị bỏ qua.
+// firstVertex là số của đỉnh đầu tiên trong file (1 với DIMACS, 0 với CSV và nhị phân).
+// Đỉnh ngoài đồ thị vertexCount đỉnh bị báo lỗi kèm số dòng như khi đọc đồ thị.
+bool loadQueries(const std::string &path, std::vector<PathQuery> &queries, int firstVertex, int vertexCount,
+                 std::string *error);
+
+#endif // GRAPHIO_H
@@ -1,20 +1,90 @@
 #include "mainwindow.h"
+#include "graphio.h"
 #include <QGraphicsEllipseItem>
-#include <QGraphicsTextItem>
+#include <QGraphicsSimpleTextItem>
+#include <QStyleOptionGraphicsItem>
+#include <QPainter>
+#include <QPainterPath>
+#include <QWheelEvent>
 #include <QFont>
 #include <QInputDialog>
 #include <QGraphicsLineItem>
 #include <QMouseEvent>
-#include <QQueue>
 #include <QMessageBox>
+#include <QFileDialog>
+#include <QHash>
 #include <QDebug>
+#include <QStatusBar>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+#include <algorithm>
+#include <chrono>
+#include <memory>
 #include <cmath> // Để tính khoảng cách Euclid
 
+namespace {
+
+// Bán kính (pixel) để nhấp chuột chọn một đỉnh có sẵn thay vì tạo đỉnh mới
+const double SnapRadius = 10.0;
+
+// Khoảng cách tối thiểu giữa hai lần gửi tiến độ (~60 khung hình/giây)
+const std::chrono::milliseconds ProgressInterval(16);
+
+// Số đỉnh tối đa được tô màu trong một khung hình; phần còn lại sang khung sau
+const int MaxStreamedPerFrame = 512;
+
+// Màu các đỉnh vừa giảm khoảng cách trong lúc giải
+const QColor StreamedVertexColor(255, 165, 0);
+
+// Đồ thị nhập từ file có nhiều cạnh (đỉnh) hơn mức này thì không vẽ cạnh và nhãn trọng số (chấm
+// và tên đỉnh): mỗi cạnh hay đỉnh tốn hai item trong scene, hàng triệu item làm mất cái lợi của
+// việc nạp file nhanh
+const int MaxDrawnImportedItems = 50000;
+
+// Tạo lớp phủ nằm trên cạnh và đỉnh: đoạn nối chỉ vẽ viền, item con chứa các chấm tròn chỉ tô màu
+QGraphicsPathItem* addOverlay(QGraphicsScene* scene, const QColor& color, QGraphicsPathItem** dots) {
+    QGraphicsPathItem* lines = scene->addPath(QPainterPath(), QPen(color, 3));
+    lines->setZValue(1);
+    *dots = new QGraphicsPathItem(lines);
+    (*dots)->setPen(Qt::NoPen);
+    (*dots)->setBrush(color);
+    return lines;
+}
+
+// Thu nhỏ dưới mức này thì không vẽ chữ, tránh hàng nghìn nhãn chồng lên nhau
+const qreal LabelMinLevelOfDetail = 0.6;
+
+// Nhãn chữ chỉ được vẽ khi đủ lớn trên màn hình.
+// QGraphicsView đã bỏ qua các item nằm ngoài vùng nhìn thấy.
+class LodTextItem : public QGraphicsSimpleTextItem
+{
+public:
+    using QGraphicsSimpleTextItem::QGraphicsSimpleTextItem;
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override {
+        if (QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform()) < LabelMinLevelOfDetail)
+            return;
+        QGraphicsSimpleTextItem::paint(painter, option, widget);
+    }
+};
+
+// Tạo tên đỉnh theo kiểu cột bảng tính: A..Z, AA..AZ, BA..
+QString vertexLabel(int id) {
+    QString label;
+    for (int n = id + 1; n > 0; n = (n - 1) / 26) {
+        label.prepend(QChar('A' + (n - 1) % 26));
+    }
+    return label;
+}
+
+}
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
+    shortestPathTree(graph),
+    pathCache(graph),
     scene(new QGraphicsScene(this)),
-    view(new QGraphicsView(scene, this)),
-    vertexCounter('A')
+    view(new QGraphicsView(scene, this))
 {
     // Cài đặt cửa sổ chính
     setWindowTitle("Bellman-Ford Visualization");
@@ -23,16 +93,24 @@ MainWindow::MainWindow(QWidget *parent)
 
     // Kích hoạt khử răng cưa
     view->setRenderHint(QPainter::Antialiasing);
+    // Ctrl + lăn chuột để phóng to/thu nhỏ quanh con trỏ
+    view->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    view->setOptimizationFlag(QGraphicsView::DontSavePainterState);
+    view->viewport()->installEventFilter(this);
 
     // Thêm ảnh bản đồ vào scene
     QPixmap mapPixmap(":/resources/map.png");
     if (mapPixmap.isNull()) {
         qDebug("Không tìm thấy ảnh bản đồ, kiểm tra đường dẫn!");
     } else {
-        QGraphicsPixmapItem *mapItem = scene->addPixmap(mapPixmap);
+        mapItem = scene->addPixmap(mapPixmap);
         mapItem->setZValue(-1);
     }
 
+    // Lớp phủ đường đi và chu trình âm, tạo một lần và dùng lại cho mọi truy vấn
+    pathOverlay = addOverlay(scene, Qt::green, &pathDots);
+    cycleOverlay = addOverlay(scene, Qt::red, &cycleDots);
+
     // Tạo nút thêm cạnh
     addEdgeButton = new QPushButton("Thêm cạnh", this);
     addEdgeButton->setGeometry(10, 50, 150, 30);
@@ -40,7 +118,7 @@ MainWindow::MainWindow(QWidget *parent)
     connect(addEdgeButton, &QPushButton::clicked, this, &MainWindow::onAddEdge);
 
     // Tạo nút "Tìm đường đi ngắn nhất"
-    QPushButton* findShortestPathButton = new QPushButton("Tìm đường đi ngắn nhất", this);
+    findShortestPathButton = new QPushButton("Tìm đường đi ngắn nhất", this);
     findShortestPathButton->setGeometry(10, 100, 150, 30);
     findShortestPathButton->setStyleSheet("background-color: red");
     connect(findShortestPathButton, &QPushButton::clicked, this, &MainWindow::onFindShortestPath);
@@ -50,45 +128,188 @@ MainWindow::MainWindow(QWidget *parent)
     toggleWeightSignButton->setGeometry(10, 150, 150, 30);
     toggleWeightSignButton->setStyleSheet("background-color: red");
     connect(toggleWeightSignButton, &QPushButton::clicked, this, &MainWindow::onToggleWeightSign);
+
+    // Chọn chế độ giải
+    solverModeBox = new QComboBox(this);
+    solverModeBox->setGeometry(10, 200, 150, 30);
+    solverModeBox->addItem("Tự động", static_cast<int>(SolverMode::Auto));
+    solverModeBox->addItem("Bellman-Ford", static_cast<int>(SolverMode::BellmanFord));
+    solverModeBox->addItem("Bellman-Ford (dừng sớm)", static_cast<int>(SolverMode::EarlyExit));
+    solverModeBox->addItem("SPFA", static_cast<int>(SolverMode::Spfa));
+    solverModeBox->addItem("Bellman-Ford song song", static_cast<int>(SolverMode::Parallel));
+    solverModeBox->addItem("Bellman-Ford (SIMD)", static_cast<int>(SolverMode::Vectorized));
+
+    // Tính sẵn mọi cặp đỉnh cho đồ thị nhỏ, truy vấn nhiều lần
+    allPairsBox = new QCheckBox("Tính mọi cặp đỉnh", this);
+    allPairsBox->setGeometry(10, 350, 150, 30);
+
+    // Nhập/xuất đồ thị từ file
+    QPushButton* importButton = new QPushButton("Nhập đồ thị", this);
+    importButton->setGeometry(10, 250, 150, 30);
+    importButton->setStyleSheet("background-color: red");
+    connect(importButton, &QPushButton::clicked, this, &MainWindow::onImportGraph);
+
+    QPushButton* exportButton = new QPushButton("Xuất đồ thị", this);
+    exportButton->setGeometry(10, 300, 150, 30);
+    exportButton->setStyleSheet("background-color: red");
+    connect(exportButton, &QPushButton::clicked, this, &MainWindow::onExportGraph);
+
+    // Thanh tiến độ và nút hủy, chỉ hiện khi đang giải
+    cancelButton = new QPushButton("Hủy", this);
+    cancelButton->setGeometry(10, 400, 150, 30);
+    cancelButton->hide();
+    connect(cancelButton, &QPushButton::clicked, this, &MainWindow::onCancelSolve);
+
+    solveProgress = new QProgressBar(this);
+    solveProgress->setGeometry(10, 450, 150, 20);
+    solveProgress->hide();
+
+    // Bảng thống kê gắn vào cạnh phải cửa sổ, bật/tắt bằng nút
+    statsDock = new QDockWidget("Thống kê", this);
+    QWidget* statsPanel = new QWidget(statsDock);
+    QVBoxLayout* statsLayout = new QVBoxLayout(statsPanel);
+    statsLabel = new QLabel(statsPanel);
+    statsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    statsLayout->addWidget(statsLabel);
+    QPushButton* exportTraceButton = new QPushButton("Xuất trace...", statsPanel);
+    connect(exportTraceButton, &QPushButton::clicked, this, &MainWindow::onExportTrace);
+    statsLayout->addWidget(exportTraceButton);
+    statsLayout->addStretch();
+    statsDock->setWidget(statsPanel);
+    addDockWidget(Qt::RightDockWidgetArea, statsDock);
+    statsDock->hide();
+    showStats(lastStats);
+
+    QPushButton* statsButton = new QPushButton("Thống kê", this);
+    statsButton->setGeometry(10, 500, 150, 30);
+    connect(statsButton, &QPushButton::clicked, statsDock->toggleViewAction(), &QAction::trigger);
+
+    connect(this, &MainWindow::solveProgressed, this, &MainWindow::onSolveProgress, Qt::QueuedConnection);
+    connect(&solveWatcher, &QFutureWatcher<ShortestPathResult>::finished, this, &MainWindow::onSolveFinished);
 }
 
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow() {
+    // Luồng giải còn dùng graph, phải dừng nó trước khi các thành viên bị hủy
+    cancelRequested = true;
+    solveWatcher.waitForFinished();
+}
 
 // Hàm tính khoảng cách Euclid
 double MainWindow::calculateEuclideanDistance(const QPointF& p1, const QPointF& p2) {
     return std::sqrt(std::pow(p1.x() - p2.x(), 2) + std::pow(p1.y() - p2.y(), 2));
 }
 
-void MainWindow::mousePressEvent(QMouseEvent *event) {
-    QPointF sceneMapped = view->mapToScene(event->pos());
-
-    // Thêm đỉnh vào đồ thị
-    QGraphicsEllipseItem *ellipse = new QGraphicsEllipseItem(sceneMapped.x() - 5, sceneMapped.y() - 5, 10, 10);
-    ellipse->setBrush(Qt::red);  // Đặt màu đỏ cho chấm
+void MainWindow::addVertexItem(int id, const QPointF& position, bool drawn) {
+    QString vertexName = vertexLabel(id);  // Tạo tên đỉnh (A, B, ..., Z, AA, AB,...)
 
-    QChar vertexName = vertexCounter;  // Tạo tên đỉnh (A, B, C,...)
-    vertexCounter = QChar(vertexCounter.toLatin1() + 1);  // Tăng giá trị của vertexCounter
+    // Lưu lại thông tin đỉnh; đỉnh không vẽ vẫn tìm được theo tên và theo vị trí
+    vertexIds.insert(vertexName, id);
+    vertexGrid.insert(id, position.x(), position.y());
+    if (!drawn) {
+        vertices.append({ position, vertexName, nullptr });
+        return;
+    }
 
-    // Lưu lại thông tin đỉnh
-    Vertex vertex = { sceneMapped, vertexName, ellipse };
-    verticesMap[vertexName] = vertex;
+    QGraphicsEllipseItem *ellipse = new QGraphicsEllipseItem(position.x() - 5, position.y() - 5, 10, 10);
+    ellipse->setBrush(Qt::red);  // Đặt màu đỏ cho chấm
+    vertices.append({ position, vertexName, ellipse });
 
-    QGraphicsTextItem* label = new QGraphicsTextItem(vertexName);
-    label->setPos(sceneMapped.x() + 10, sceneMapped.y() + 10);  // Đặt tên đỉnh gần vị trí của chấm
+    LodTextItem* label = new LodTextItem(vertexName);
+    label->setPos(position.x() + 10, position.y() + 10);  // Đặt tên đỉnh gần vị trí của chấm
 
     scene->addItem(ellipse);
     scene->addItem(label);
 }
 
+void MainWindow::drawEdge(Edge& edge) {
+    const QPointF& fromPosition = vertices[edge.from].position;
+    const QPointF& toPosition = vertices[edge.to].position;
+
+    // Vẽ cạnh lên scene
+    edge.lineItem = scene->addLine(QLineF(fromPosition, toPosition), QPen(Qt::blue, 5));
+    QPointF midpoint = (fromPosition + toPosition) / 2;
+
+    // Hiển thị trọng số tại trung điểm
+    edge.labelItem = new LodTextItem(QString::number(edge.weight));
+    edge.labelItem->setPos(midpoint);
+    edge.labelItem->setBrush(Qt::black);
+    scene->addItem(edge.labelItem);
+}
+
+int MainWindow::findVertex(const QString& name) const {
+    return vertexIds.value(name.trimmed().toUpper(), -1);
+}
+
+void MainWindow::selectVertex(int id) {
+    // Giữ lại tối đa hai đỉnh được chọn gần nhất
+    if (selectedVertices.size() == 2) {
+        if (QGraphicsEllipseItem* ellipse = vertices[selectedVertices.takeFirst()].ellipseItem)
+            ellipse->setPen(QPen(Qt::black));
+    }
+    selectedVertices.append(id);
+    if (vertices[id].ellipseItem)
+        vertices[id].ellipseItem->setPen(QPen(Qt::yellow, 3));
+}
+
+QString MainWindow::selectedVerticesText() const {
+    QStringList labels;
+    for (int id : selectedVertices) {
+        labels.append(vertices[id].label);
+    }
+    return labels.join(" ");
+}
+
+bool MainWindow::isSolving() const {
+    return solving;
+}
+
+void MainWindow::mousePressEvent(QMouseEvent *event) {
+    QPointF sceneMapped = view->mapToScene(event->pos());
+
+    // Nhấp gần một đỉnh có sẵn thì chọn đỉnh đó
+    int nearest = vertexGrid.nearest(sceneMapped.x(), sceneMapped.y(), SnapRadius);
+    if (nearest != -1) {
+        selectVertex(nearest);
+        return;
+    }
+
+    // Luồng giải đang đọc graph, không cho sửa đồ thị
+    if (isSolving()) {
+        statusBar()->showMessage("Đang tìm đường đi, chưa thể sửa đồ thị.", 2000);
+        return;
+    }
+
+    // Thêm đỉnh vào đồ thị
+    addVertexItem(graph.addVertex(), sceneMapped);
+    shortestPathTree.vertexAdded();
+}
+
+bool MainWindow::eventFilter(QObject *watched, QEvent *event) {
+    // Ctrl + lăn chuột trên vùng vẽ để phóng to/thu nhỏ, lăn thường vẫn cuộn như cũ
+    if (watched == view->viewport() && event->type() == QEvent::Wheel) {
+        QWheelEvent *wheel = static_cast<QWheelEvent*>(event);
+        if (wheel->modifiers() & Qt::ControlModifier) {
+            qreal factor = std::pow(1.0015, wheel->angleDelta().y());
+            view->scale(factor, factor);
+            return true;
+        }
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
+
 void MainWindow::onAddEdge() {
-    if (verticesMap.size() < 2) {
+    if (isSolving()) {
+        statusBar()->showMessage("Đang tìm đường đi, chưa thể sửa đồ thị.", 2000);
+        return;
+    }
+    if (vertices.size() < 2) {
         qDebug("Cần ít nhất 2 đỉnh để thêm cạnh.");
         return;
     }
 
     // Hiển thị hộp thoại để chọn hai đỉnh
     bool ok;
-    QString edgeData = QInputDialog::getText(this, "Thêm cạnh", "Nhập hai đỉnh (ví dụ: A B):", QLineEdit::Normal, "", &ok);
+    QString edgeData = QInputDialog::getText(this, "Thêm cạnh", "Nhập hai đỉnh (ví dụ: A B):", QLineEdit::Normal, selectedVerticesText(), &ok);
 
     if (!ok || edgeData.isEmpty())
         return;
@@ -100,160 +321,414 @@ void MainWindow::onAddEdge() {
         return;
     }
 
-    QChar from = parts[0].at(0).toUpper();
-    QChar to = parts[1].at(0).toUpper();
+    int from = findVertex(parts[0]);
+    int to = findVertex(parts[1]);
 
-    if (!verticesMap.contains(from) || !verticesMap.contains(to)) {
+    if (from == -1 || to == -1) {
         qDebug("Một hoặc cả hai đỉnh không tồn tại.");
         return;
     }
 
     // Tính khoảng cách Euclid làm trọng số
-    Vertex fromVertex = verticesMap[from];
-    Vertex toVertex = verticesMap[to];
-    double distance = calculateEuclideanDistance(fromVertex.position, toVertex.position);
+    double distance = calculateEuclideanDistance(vertices[from].position, vertices[to].position);
     int weight = static_cast<int>(distance);
-
-    // Vẽ cạnh lên scene
-    QGraphicsLineItem* line = scene->addLine(QLineF(fromVertex.position, toVertex.position), QPen(Qt::blue, 5));
-    QPointF midpoint = (fromVertex.position + toVertex.position) / 2;
-
-    // Hiển thị trọng số tại trung điểm
-    QGraphicsTextItem* textItem = new QGraphicsTextItem(QString::number(weight));
-    textItem->setPos(midpoint);
-    textItem->setDefaultTextColor(Qt::black);
-    scene->addItem(textItem);
+    Edge edge{from, to, weight, nullptr, nullptr};
+    drawEdge(edge);
 
     // Lưu thông tin cạnh và trọng số
-    edges.append({from, to, weight});
-    edges.append({to, from, weight});
+    edges.append(edge);
+    edges.append({to, from, weight, edge.lineItem, edge.labelItem});
+    int forward = graph.addEdge(from, to, weight);
+    int backward = graph.addEdge(to, from, weight);
+    shortestPathTree.edgeAdded(forward);
+    shortestPathTree.edgeAdded(backward);
 }
 
 void MainWindow::onFindShortestPath() {
+    if (isSolving())
+        return;
+
     bool ok;
-    QString source = QInputDialog::getText(this, "Nhập đỉnh nguồn", "Nhập đỉnh nguồn:", QLineEdit::Normal, "", &ok);
-    QString target = QInputDialog::getText(this, "Nhập đỉnh đích", "Nhập đỉnh đích:", QLineEdit::Normal, "", &ok);
+    QString source = QInputDialog::getText(this, "Nhập đỉnh nguồn", "Nhập đỉnh nguồn:", QLineEdit::Normal,
+                                           selectedVertices.size() > 0 ? vertices[selectedVertices[0]].label : QString(), &ok);
+    QString target = QInputDialog::getText(this, "Nhập đỉnh đích", "Nhập đỉnh đích:", QLineEdit::Normal,
+                                           selectedVertices.size() > 1 ? vertices[selectedVertices[1]].label : QString(), &ok);
 
     if (!ok || source.isEmpty() || target.isEmpty()) return;
 
-    // Khởi tạo các giá trị cho thuật toán Bellman-Ford
-    QMap<QChar, int> distance;  // Khoảng cách từ nguồn
-    QMap<QChar, QChar> previous;  // Lưu lại đỉnh đi qua
-
-    for (const QChar& vertex : verticesMap.keys()) {
-        distance[vertex] = INT_MAX;  // Đặt khoảng cách ban đầu là vô hạn
-        previous[vertex] = QChar();  // Chưa có đỉnh đi qua
+    int sourceId = findVertex(source);
+    int targetId = findVertex(target);
+    if (sourceId == -1 || targetId == -1) {
+        QMessageBox::warning(this, "Lỗi", "Một hoặc cả hai đỉnh không tồn tại.");
+        return;
     }
-    distance[source.at(0)] = 0;  // Đặt khoảng cách từ nguồn về 0
 
-    // Thuật toán Bellman-Ford
-    for (int i = 0; i < verticesMap.size() - 1; ++i) {
-        for (const Edge& edge : edges) {
-            QChar u = edge.from;
-            QChar v = edge.to;
-            int weight = edge.weight;
+    SolverOptions options;
+    options.mode = static_cast<SolverMode>(solverModeBox->currentData().toInt());
 
-            // Cập nhật khoảng cách
-            if (distance[u] != INT_MAX && distance[u] + weight < distance[v]) {
-                distance[v] = distance[u] + weight;
-                previous[v] = u;
-            }
+    if (allPairsBox->isChecked() && graph.vertexCount() <= AllPairsShortestPaths::MaxVertices) {
+        // Bảng mọi cặp đỉnh chỉ tính lại khi đồ thị thay đổi
+        if (!allPairs.isCurrent(graph)) {
+            startSolve(sourceId, targetId, options, true);
+            return;
         }
+        bool hasNegativeCycle = allPairs.hasNegativeCycle();
+        showShortestPath(sourceId, targetId,
+                         hasNegativeCycle ? std::vector<int>() : allPairs.path(sourceId, targetId),
+                         hasNegativeCycle ? 0 : allPairs.distance(sourceId, targetId),
+                         !hasNegativeCycle && allPairs.overflowed() && allPairs.distance(sourceId, targetId) == INT_MIN,
+                         hasNegativeCycle, "Floyd-Warshall (mọi cặp đỉnh)");
+        return;
     }
 
-    // Kiểm tra chu trình âm sau khi thuật toán Bellman-Ford kết thúc
-    bool hasNegativeCycle = false;
-    for (const Edge& edge : edges) {
-        QChar u = edge.from;
-        QChar v = edge.to;
-        int weight = edge.weight;
-
-        // Nếu có thể cập nhật được trọng số, chứng tỏ có chu trình âm
-        if (distance[u] != INT_MAX && distance[u] + weight < distance[v]) {
-            // Tìm chu trình âm
-            hasNegativeCycle = true;
-            break;
+    if (options.mode == SolverMode::Auto) {
+        // Dùng lại cây đã được sửa dần nếu cùng đỉnh nguồn, sau đó tới bộ nhớ đệm,
+        // chỉ giải lại khi cả hai đều không có
+        const ShortestPathResult* shortest = nullptr;
+        QString note;
+        if (shortestPathTree.isValid() && shortestPathTree.source() == sourceId) {
+            shortest = &shortestPathTree.result();
+            note = " (cập nhật tăng dần)";
+        } else if ((shortest = pathCache.find(sourceId)) != nullptr) {
+            note = " (bộ nhớ đệm)";
+        }
+        if (shortest) {
+            // Kết quả của chế độ tự động không đến từ SPFA nên tìm đỉnh -vô cùng chỉ mất một lượt
+            showResult(sourceId, targetId, *shortest, QString::fromLatin1(algorithmName(shortest->algorithm)) + note,
+                       graph.unboundedVertices(*shortest));
+            return;
         }
     }
 
-    if (hasNegativeCycle) {
-        // Kiểm tra và tìm chu trình âm bắt đầu từ nguồn
-        QMap<QChar, bool> inCycle;
-        QChar current = source.at(0);
-
-        // Dùng thuật toán tìm chu trình âm
-        QList<QChar> cycle;
-        QChar cycleStart = current;
-
-        // Lần theo chu trình âm
-        while (previous.contains(current) && !inCycle.contains(current)) {
-            inCycle[current] = true;
-            cycle.append(current);
-            current = previous[current];
+    startSolve(sourceId, targetId, options, false);
+}
+
+void MainWindow::startSolve(int sourceId, int targetId, const SolverOptions& options, bool allPairsMode) {
+    solveSource = sourceId;
+    solveTarget = targetId;
+    solveAllPairs = allPairsMode;
+    solveMode = options.mode;
+    solving = true;
+    cancelRequested = false;
+    progressPending = false;
+    clearStreamedVertices();
+    streamed.fill(0, vertices.size());
+
+    findShortestPathButton->setEnabled(false);
+    cancelButton->show();
+    solveProgress->setRange(0, 0);  // Chưa biết số lượt thì chạy dạng bận
+    solveProgress->show();
+
+    // Dựng CSR trước trên luồng giao diện để luồng giải chỉ còn đọc
+    graph.csrView();
+
+    SolverOptions solverOptions = options;
+    solverOptions.progress = makeProgressCallback();
+    auto cycles = std::make_shared<CycleReport>();
+    solveCycles = cycles;
+    if (allPairsMode) {
+        ProgressCallback progress = solverOptions.progress;
+        solveWatcher.setFuture(QtConcurrent::run([this, progress, cycles]() {
+            ShortestPathResult result;
+            result.cancelled = !allPairs.compute(graph, 0, progress);
+            // Bảng Floyd-Warshall không giữ được chu trình, tìm lại trên toàn đồ thị để tô lên
+            if (!result.cancelled && allPairs.hasNegativeCycle())
+                cycles->graphCycle = graph.findNegativeCycle(0, progress);
+            return result;
+        }));
+    } else {
+        solveWatcher.setFuture(QtConcurrent::run([this, sourceId, solverOptions, cycles]() {
+            ShortestPathResult result = graph.shortestPaths(sourceId, solverOptions);
+            if (result.cancelled || graph.negativeEdgeCount() == 0)
+                return result;
+            if (result.hasNegativeCycle) {
+                cycles->unbounded = graph.unboundedVertices(result);
+            } else if (result.algorithm != Algorithm::Johnson) {
+                // Chu trình âm nguồn không tới được không làm sai kết quả nhưng vẫn cần báo.
+                // Johnson chạy được nghĩa là cả đồ thị không có chu trình âm. Engine nhớ kết quả
+                // theo phiên bản đồ thị nên chỉ lần giải đầu sau mỗi lần sửa mới phải tìm;
+                // số luồng do engine chọn theo kích thước đồ thị.
+                cycles->graphCycle = graph.findNegativeCycle(0, solverOptions.progress);
+            }
+            return result;
+        }));
+    }
+}
+
+ProgressCallback MainWindow::makeProgressCallback() {
+    // Trạng thái riêng của luồng giải: khoảng cách đã gửi đi và thời điểm gửi gần nhất
+    struct Relay {
+        std::vector<int> sentDistance;
+        std::chrono::steady_clock::time_point lastSent;
+    };
+    auto relay = std::make_shared<Relay>();
+    relay->sentDistance.assign(graph.vertexCount(), GraphEngine::Infinity);
+
+    return [this, relay](const SolverProgress& progress) {
+        if (cancelRequested)
+            return false;
+
+        // Gộp các lượt lại, chỉ gửi khi giao diện đã xử lý xong lần trước và đủ một khung hình
+        auto now = std::chrono::steady_clock::now();
+        if (progressPending || now - relay->lastSent < ProgressInterval)
+            return true;
+        relay->lastSent = now;
+
+        // Chỉ gửi các đỉnh giảm khoảng cách kể từ lần trước; đỉnh vượt giới hạn để khung sau
+        QVector<int> changed;
+        if (progress.distance) {
+            for (int v = 0; v < static_cast<int>(relay->sentDistance.size())
+                            && changed.size() < MaxStreamedPerFrame; ++v) {
+                if (progress.distance[v] < relay->sentDistance[v]) {
+                    relay->sentDistance[v] = progress.distance[v];
+                    changed.append(v);
+                }
+            }
         }
+        progressPending = true;
+        emit solveProgressed(progress.round, progress.totalRounds, changed);
+        return true;
+    };
+}
+
+void MainWindow::onSolveProgress(int round, int totalRounds, QVector<int> changedVertices) {
+    progressPending = false;
+    if (!isSolving())
+        return;
 
-        // Nếu phát hiện chu trình, thông báo lỗi
-        if (inCycle.contains(current)) {
-            QMessageBox::critical(this, "Lỗi", "Đồ thị chứa chu trình âm.");
+    solveProgress->setRange(0, std::max(1, totalRounds));
+    solveProgress->setValue(std::min(round, totalRounds));
+    if (statsDock->isVisible())
+        statsLabel->setText(QString("Đang giải: lượt %1/%2").arg(round).arg(totalRounds));
+
+    // Chỉ đổi màu các đỉnh có sẵn, không tạo item mới trong lúc giải
+    for (int id : changedVertices) {
+        if (id < streamed.size() && !streamed[id] && vertices[id].ellipseItem) {
+            streamed[id] = 1;
+            streamedVertices.append(id);
+            vertices[id].ellipseItem->setBrush(StreamedVertexColor);
         }
-        return;  // Dừng lại và không tiếp tục thực hiện
     }
+}
 
-    // Nếu không có chu trình âm, tiếp tục thực hiện tìm đường đi ngắn nhất
-    QList<QChar> path;
-    QChar current = target.at(0);
-    int totalWeight = 0;
+void MainWindow::onCancelSolve() {
+    cancelRequested = true;
+    cancelButton->setEnabled(false);
+}
 
-    while (current != QChar()) {
-        path.prepend(current);
-        current = previous[current];
+void MainWindow::clearStreamedVertices() {
+    for (int id : streamedVertices) {
+        vertices[id].ellipseItem->setBrush(Qt::red);
     }
+    streamedVertices.clear();
+    streamed.clear();
+}
 
-    // Tính tổng trọng số
-    for (int i = 0; i < path.size() - 1; ++i) {
-        QChar u = path[i];
-        QChar v = path[i + 1];
-        for (const Edge& edge : edges) {
-            if (edge.from == u && edge.to == v) {
-                totalWeight += edge.weight;
-                break;
-            }
+void MainWindow::onSolveFinished() {
+    ShortestPathResult computed = solveWatcher.result();
+    solving = false;
+
+    findShortestPathButton->setEnabled(true);
+    cancelButton->setEnabled(true);
+    cancelButton->hide();
+    solveProgress->hide();
+    clearStreamedVertices();
+
+    if (computed.cancelled) {
+        showStats(computed.stats);
+        statusBar()->showMessage("Đã hủy tìm đường đi.", 3000);
+        return;
+    }
+
+    if (solveAllPairs) {
+        showStats(computed.stats);
+        bool hasNegativeCycle = allPairs.hasNegativeCycle();
+        if (hasNegativeCycle && !solveCycles->graphCycle.empty()) {
+            showNegativeCycle(solveSource, solveTarget, solveCycles->graphCycle, std::vector<int>(),
+                              "Floyd-Warshall (mọi cặp đỉnh)");
+            return;
         }
+        showShortestPath(solveSource, solveTarget,
+                         hasNegativeCycle ? std::vector<int>() : allPairs.path(solveSource, solveTarget),
+                         hasNegativeCycle ? 0 : allPairs.distance(solveSource, solveTarget),
+                         !hasNegativeCycle && allPairs.overflowed() && allPairs.distance(solveSource, solveTarget) == INT_MIN,
+                         hasNegativeCycle, "Floyd-Warshall (mọi cặp đỉnh)");
+        return;
     }
 
-    // Chuyển QList<QChar> thành QStringList
+    // Chế độ tự động giữ kết quả lại để sửa dần và dùng cho các truy vấn sau
+    const ShortestPathResult* shortest = &computed;
+    if (solveMode == SolverMode::Auto) {
+        shortestPathTree.reset(std::move(computed));
+        shortest = &pathCache.insert(shortestPathTree.result());
+    }
+
+    showResult(solveSource, solveTarget, *shortest, QString::fromLatin1(algorithmName(shortest->algorithm)),
+               solveCycles->unbounded);
+
+    if (!solveCycles->graphCycle.empty()) {
+        QString cycleText = highlightCycle(solveCycles->graphCycle, std::vector<int>());
+        statusBar()->showMessage("Đồ thị có chu trình âm mà " + vertices[solveSource].label
+                                 + " không tới được: " + cycleText);
+    }
+}
+
+void MainWindow::showResult(int sourceId, int targetId, const ShortestPathResult& result,
+                            const QString& algorithmText, const std::vector<int>& unbounded) {
+    if (result.hasNegativeCycle && !result.negativeCycle.empty()) {
+        showNegativeCycle(sourceId, targetId, result.negativeCycle, unbounded, algorithmText);
+    } else {
+        bool reachable = result.reachable(targetId);
+        bool overflowed = reachable && result.overflowed && result.distance[targetId] == INT_MIN;
+        showShortestPath(sourceId, targetId, result.pathTo(targetId), reachable ? result.distance[targetId] : 0,
+                         overflowed, result.hasNegativeCycle, algorithmText);
+    }
+    // Sau pathTo để có cả pha dựng đường đi
+    showStats(result.stats);
+}
+
+void MainWindow::showStats(const SolverStats& stats) {
+    lastStats = stats;
+#ifdef FORDBELLMAN_STATS
+    QString text = QString("Số lượt: %1\nRelax: %2 (thành công %3)\nĐưa vào hàng đợi: %4\n")
+                       .arg(stats.passes).arg(stats.relaxationsAttempted)
+                       .arg(stats.relaxationsSucceeded).arg(stats.queuePushes);
+    const SolverPhase phases[] = {SolverPhase::Init, SolverPhase::Potential, SolverPhase::Relax,
+                                  SolverPhase::NegativeCycleCheck, SolverPhase::PathReconstruction};
+    for (SolverPhase phase : phases) {
+        text += QString("\n%1: %2 ms").arg(QString::fromLatin1(solverPhaseName(phase)))
+                    .arg(stats.phaseDuration(phase) / 1e6, 0, 'f', 3);
+    }
+    statsLabel->setText(text);
+#else
+    statsLabel->setText("Chưa có bộ đếm.\nDựng lại với -DFORDBELLMAN_STATS=ON.");
+#endif
+}
+
+void MainWindow::onExportTrace() {
+    if (lastStats.phases.empty()) {
+        QMessageBox::information(this, "Thống kê", "Chưa có số liệu của lần giải nào để xuất.");
+        return;
+    }
+    QString path = QFileDialog::getSaveFileName(this, "Xuất Chrome trace", QString(), "Chrome trace (*.json)");
+    if (path.isEmpty())
+        return;
+    std::string error;
+    if (!writeChromeTrace(path.toStdString(), {lastStats}, &error))
+        QMessageBox::warning(this, "Lỗi", QString::fromStdString(error));
+}
+
+void MainWindow::showShortestPath(int sourceId, int targetId, const std::vector<int>& path, int totalWeight,
+                                  bool weightOverflowed, bool hasNegativeCycle, const QString& algorithmText) {
+    const QString& source = vertices[sourceId].label;
+    const QString& target = vertices[targetId].label;
+    clearOverlays();
+
+    if (hasNegativeCycle) {
+        QMessageBox::critical(this, "Lỗi", "Đồ thị chứa chu trình âm.");
+        return;  // Dừng lại và không tiếp tục thực hiện
+    }
+
+    if (path.empty()) {
+        QMessageBox::information(this, "Kết quả", "Không có đường đi từ " + source + " đến " + target + ".");
+        return;
+    }
+
+    // Chuyển đường đi từ id đỉnh sang tên đỉnh
     QStringList pathStringList;
-    for (const QChar& c : path) {
-        pathStringList.append(QString(c));
+    for (int id : path) {
+        pathStringList.append(vertices[id].label);
     }
 
     QString result = "Đường đi ngắn nhất từ " + source + " đến " + target + ": " + pathStringList.join(" -> ");
-    result += "\nTổng trọng số: " + QString::number(totalWeight);
+    if (weightOverflowed) {
+        result += "\nTổng trọng số: nhỏ hơn " + QString::number(INT_MIN) + " (vượt phạm vi int, không có chu trình âm)";
+    } else {
+        result += "\nTổng trọng số: " + QString::number(totalWeight);
+    }
+    result += "\nThuật toán: " + algorithmText;
 
     QMessageBox::information(this, "Kết quả", result);
 
-    // Tô màu các đỉnh và cạnh trên đường đi ngắn nhất
-    for (int i = 0; i < path.size(); ++i) {
-        QChar vertex = path[i];
-        Vertex vertexInfo = verticesMap[vertex];
-        vertexInfo.ellipseItem->setBrush(Qt::green);
-        coloredVertices.append(vertexInfo.ellipseItem);
+    // Tô màu các đỉnh và cạnh trên đường đi ngắn nhất: đường gấp khúc qua các đỉnh
+    // cùng các chấm tròn, thay cho lần vẽ trước
+    QPainterPath highlight(vertices[path.front()].position);
+    for (size_t i = 1; i < path.size(); ++i) {
+        highlight.lineTo(vertices[path[i]].position);
+    }
+    QPainterPath dots;
+    for (int id : path) {
+        dots.addEllipse(vertices[id].position, 5, 5);
+    }
+    pathOverlay->setPath(highlight);
+    pathDots->setPath(dots);
+}
+
+void MainWindow::showNegativeCycle(int sourceId, int targetId, const std::vector<int>& cycle,
+                                   const std::vector<int>& unbounded, const QString& algorithmText) {
+    const QString& source = vertices[sourceId].label;
+    const QString& target = vertices[targetId].label;
+    clearOverlays();
+
+    QString message = "Đồ thị chứa chu trình âm: " + highlightCycle(cycle, unbounded);
+    if (!unbounded.empty()) {
+        bool targetUnbounded = std::find(unbounded.begin(), unbounded.end(), targetId) != unbounded.end();
+        message += "\n" + QString::number(unbounded.size()) + " đỉnh có khoảng cách -∞ tính từ " + source + ", ";
+        message += targetUnbounded ? "trong đó có " + target + "." : "không gồm " + target + ".";
     }
+    message += "\nThuật toán: " + algorithmText;
+    QMessageBox::warning(this, "Chu trình âm", message);
+}
 
-    for (int i = 0; i < path.size() - 1; ++i) {
-        QChar u = path[i];
-        QChar v = path[i + 1];
-        QPointF uPos = verticesMap[u].position;
-        QPointF vPos = verticesMap[v].position;
-        QGraphicsLineItem* line = new QGraphicsLineItem(QLineF(uPos, vPos));
-        line->setPen(QPen(Qt::green, 3));
-        scene->addItem(line);
-        coloredEdges.append(line);
+// Vẽ chu trình lên lớp phủ đỏ, các đỉnh -vô cùng thành chấm nhỏ hơn; trả về chu trình dạng chữ
+QString MainWindow::highlightCycle(const std::vector<int>& cycle, const std::vector<int>& unbounded) {
+    // Trọng số mỗi bước lấy cạnh nhẹ nhất giữa hai đỉnh, duyệt danh sách cạnh một lần
+    QHash<quint64, int> stepWeights;
+    auto stepKey = [](int from, int to) { return (static_cast<quint64>(from) << 32) | static_cast<quint32>(to); };
+    for (size_t i = 0; i < cycle.size(); ++i) {
+        stepWeights.insert(stepKey(cycle[i], cycle[(i + 1) % cycle.size()]), GraphEngine::Infinity);
+    }
+    for (int e = 0; e < graph.edgeCount(); ++e) {
+        auto it = stepWeights.find(stepKey(graph.edgeSource(e), graph.edgeTarget(e)));
+        if (it != stepWeights.end()) {
+            *it = std::min(*it, graph.edgeWeight(e));
+        }
     }
+
+    QStringList labels;
+    long long totalWeight = 0;
+    QPainterPath lines(vertices[cycle.front()].position);
+    QPainterPath dots;
+    for (size_t i = 0; i < cycle.size(); ++i) {
+        labels.append(vertices[cycle[i]].label);
+        totalWeight += stepWeights.value(stepKey(cycle[i], cycle[(i + 1) % cycle.size()]));
+        lines.lineTo(vertices[cycle[(i + 1) % cycle.size()]].position);
+        dots.addEllipse(vertices[cycle[i]].position, 6, 6);
+    }
+    for (int id : unbounded) {
+        dots.addEllipse(vertices[id].position, 3, 3);
+    }
+    dots.setFillRule(Qt::WindingFill);  // Chấm chồng lên nhau không bị khoét lỗ
+    cycleOverlay->setPath(lines);
+    cycleDots->setPath(dots);
+
+    labels.append(labels.front());
+    return labels.join(" -> ") + " (tổng trọng số " + QString::number(totalWeight) + ")";
+}
+
+void MainWindow::clearOverlays() {
+    pathOverlay->setPath(QPainterPath());
+    pathDots->setPath(QPainterPath());
+    cycleOverlay->setPath(QPainterPath());
+    cycleDots->setPath(QPainterPath());
 }
 
 void MainWindow::onToggleWeightSign()
 {
+    if (isSolving()) {
+        statusBar()->showMessage("Đang tìm đường đi, chưa thể sửa đồ thị.", 2000);
+        return;
+    }
     if (edges.isEmpty()) {
         QMessageBox::information(this, "Thông báo", "Không có cạnh nào để đảo dấu.");
         return;
@@ -264,7 +739,7 @@ void MainWindow::onToggleWeightSign()
     QString edgeData = QInputDialog::getText(
         this, "Đảo dấu trọng số",
         "Nhập hai đỉnh của cạnh cần đổi dấu (ví dụ: A B):",
-        QLineEdit::Normal, "", &ok);
+        QLineEdit::Normal, selectedVerticesText(), &ok);
 
     if (!ok || edgeData.isEmpty())
         return;
@@ -276,28 +751,23 @@ void MainWindow::onToggleWeightSign()
         return;
     }
 
-    QChar from = parts[0].at(0).toUpper();
-    QChar to = parts[1].at(0).toUpper();
+    int from = findVertex(parts[0]);
+    int to = findVertex(parts[1]);
 
     // Tìm và đổi dấu trọng số của cạnh
     bool edgeFound = false;
-    for (Edge& edge : edges) {
+    for (int i = 0; i < edges.size(); ++i) {
+        Edge& edge = edges[i];
         if ((edge.from == from && edge.to == to) || (edge.from == to && edge.to == from)) {
+            int oldWeight = edge.weight;
             edge.weight = -edge.weight;  // Đảo dấu trọng số
+            graph.setEdgeWeight(i, edge.weight);
+            shortestPathTree.edgeWeightChanged(i, oldWeight);
             edgeFound = true;
 
-            // Cập nhật hiển thị trọng số trên scene
-            for (QGraphicsItem* item : scene->items()) {
-                if (auto textItem = dynamic_cast<QGraphicsTextItem*>(item)) {
-                    QString text = textItem->toPlainText();
-                    bool ok;
-                    int weight = text.toInt(&ok);
-                    if (ok && weight == -edge.weight) {
-                        textItem->setPlainText(QString::number(edge.weight));
-                        break;
-                    }
-                }
-            }
+            // Cập nhật hiển thị trọng số trên scene (cạnh của đồ thị lớn không được vẽ)
+            if (edge.labelItem)
+                edge.labelItem->setText(QString::number(edge.weight));
             break;
         }
     }
@@ -305,6 +775,113 @@ void MainWindow::onToggleWeightSign()
     if (!edgeFound) {
         QMessageBox::warning(this, "Lỗi", "Cạnh không tồn tại trong đồ thị.");
     } else {
-        QMessageBox::information(this, "Thành công", "Đã đảo dấu trọng số của cạnh " + QString(from) + " -> " + QString(to) + ".");
+        QMessageBox::information(this, "Thành công", "Đã đảo dấu trọng số của cạnh " + vertices[from].label + " -> " + vertices[to].label + ".");
+    }
+}
+
+void MainWindow::onImportGraph()
+{
+    if (isSolving()) {
+        statusBar()->showMessage("Đang tìm đường đi, chưa thể sửa đồ thị.", 2000);
+        return;
+    }
+    QString fileName = QFileDialog::getOpenFileName(
+        this, "Nhập đồ thị", QString(),
+        "Đồ thị (*.gr *.csv *.fbg);;DIMACS (*.gr);;CSV (*.csv);;Nhị phân (*.fbg)");
+    if (fileName.isEmpty())
+        return;
+
+    // Đọc thẳng vào graph; nếu lỗi thì đồ thị hiện tại được giữ nguyên
+    std::vector<float> positions;
+    std::string error;
+    if (!loadGraph(QFile::encodeName(fileName).toStdString(), graph, &positions, &error)) {
+        QMessageBox::warning(this, "Lỗi", QString::fromStdString(error));
+        return;
+    }
+
+    // Xóa đồ thị cũ khỏi scene, giữ lại ảnh bản đồ và các lớp phủ
+    clearOverlays();
+    for (QGraphicsItem* item : scene->items()) {
+        if (item != mapItem && item != pathOverlay && item != cycleOverlay && !item->parentItem()) {
+            scene->removeItem(item);
+            delete item;
+        }
+    }
+    shortestPathTree.invalidate();
+    pathCache.clear();
+    allPairs.clear();
+    vertices.clear();
+    vertexIds.clear();
+    edges.clear();
+    vertexGrid.clear();
+    selectedVertices.clear();
+
+    // File không có tọa độ thì xếp các đỉnh thành lưới phủ lên bản đồ
+    const int n = graph.vertexCount();
+    const bool hasPositions = positions.size() == static_cast<size_t>(2 * n);
+    QRectF area = mapItem ? mapItem->boundingRect() : QRectF(0, 0, 800, 600);
+    int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(n)))));
+    double step = area.width() / (columns + 1);
+    const bool drawVertices = n <= MaxDrawnImportedItems;
+    vertices.reserve(n);
+    vertexIds.reserve(n);
+    for (int id = 0; id < n; ++id) {
+        QPointF position = hasPositions
+            ? QPointF(positions[2 * id], positions[2 * id + 1])
+            : QPointF(area.left() + step * (id % columns + 1), area.top() + step * (id / columns + 1));
+        addVertexItem(id, position, drawVertices);
+    }
+
+    // Cạnh hai chiều chỉ vẽ một lần, chiều còn lại dùng chung item
+    const bool drawEdges = drawVertices && graph.edgeCount() <= MaxDrawnImportedItems;
+    QHash<QPair<int, int>, int> drawn;
+    edges.reserve(graph.edgeCount());
+    for (int e = 0; e < graph.edgeCount(); ++e) {
+        Edge edge{graph.edgeSource(e), graph.edgeTarget(e), graph.edgeWeight(e), nullptr, nullptr};
+        if (!drawEdges) {
+            edges.append(edge);
+            continue;
+        }
+        QPair<int, int> key(std::min(edge.from, edge.to), std::max(edge.from, edge.to));
+        auto it = drawn.constFind(key);
+        if (it == drawn.constEnd()) {
+            drawn.insert(key, e);
+            drawEdge(edge);
+        } else {
+            edge.lineItem = edges[*it].lineItem;
+            edge.labelItem = edges[*it].labelItem;
+        }
+        edges.append(edge);
+    }
+
+    QString message = "Đã nhập " + QString::number(n) + " đỉnh và " + QString::number(graph.edgeCount()) + " cạnh.";
+    if (!drawVertices)
+        message += "\nĐồ thị quá lớn nên các đỉnh và cạnh không được vẽ; đường đi tìm được vẫn hiển thị.";
+    else if (!drawEdges)
+        message += "\nĐồ thị quá lớn nên các cạnh không được vẽ; đường đi tìm được vẫn hiển thị.";
+    QMessageBox::information(this, "Thành công", message);
+}
+
+void MainWindow::onExportGraph()
+{
+    QString fileName = QFileDialog::getSaveFileName(
+        this, "Xuất đồ thị", QString(),
+        "Nhị phân (*.fbg);;DIMACS (*.gr);;CSV (*.csv)");
+    if (fileName.isEmpty())
+        return;
+
+    // Chỉ định dạng nhị phân giữ được vị trí các đỉnh trên bản đồ
+    std::vector<float> positions;
+    positions.reserve(2 * vertices.size());
+    for (const Vertex& vertex : vertices) {
+        positions.push_back(static_cast<float>(vertex.position.x()));
+        positions.push_back(static_cast<float>(vertex.position.y()));
+    }
+
+    std::string error;
+    if (!saveGraph(QFile::encodeName(fileName).toStdString(), graph, &positions, &error)) {
+        QMessageBox::warning(this, "Lỗi", QString::fromStdString(error));
+        return;
     }
+    QMessageBox::information(this, "Thành công", "Đã xuất đồ thị ra " + fileName + ".");
 }
@@ -5,10 +5,25 @@
 #include <QGraphicsScene>
 #include <QGraphicsView>
 #include <QPushButton>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QProgressBar>
+#include <QDockWidget>
+#include <QLabel>
+#include <QFutureWatcher>
 #include <QVector>
-#include <QMap>
+#include <QHash>
 #include <QGraphicsEllipseItem>
 #include <QGraphicsLineItem>
+#include <QGraphicsPathItem>
+#include <QGraphicsSimpleTextItem>
+#include "graphengine.h"
+#include "dynamicshortestpaths.h"
+#include "shortestpathcache.h"
+#include "allpairs.h"
+#include "spatialgrid.h"
+#include <atomic>
+#include <memory>
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
@@ -21,39 +36,113 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+signals:
+    // Phát từ luồng giải, nhận trên luồng giao diện qua kết nối hàng đợi
+    void solveProgressed(int round, int totalRounds, QVector<int> changedVertices);
+
 protected:
     void mousePressEvent(QMouseEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
 
 private slots:
     void onAddEdge();
     void onFindShortestPath();
     void onToggleWeightSign();
+    void onImportGraph();
+    void onExportGraph();
+    void onCancelSolve();
+    void onSolveProgress(int round, int totalRounds, QVector<int> changedVertices);
+    void onSolveFinished();
+    void onExportTrace();
     double calculateEuclideanDistance(const QPointF& p1, const QPointF& p2);
 
 
 private:
     struct Vertex {
         QPointF position;
-        QChar label;
+        QString label;
         QGraphicsEllipseItem *ellipseItem; // Thêm item đồ họa vào đây
     };
 
     struct Edge {
-        QChar from;
-        QChar to;
+        int from;
+        int to;
         int weight;
+        // Hai chiều của một cạnh dùng chung đường vẽ và nhãn trọng số
+        QGraphicsLineItem *lineItem;
+        QGraphicsSimpleTextItem *labelItem;
     };
 
-    QMap<QChar, Vertex> verticesMap; // Lưu thông tin các đỉnh
-    QVector<Edge> edges;  // Danh sách các cạnh
+    void addVertexItem(int id, const QPointF& position, bool drawn = true);  // drawn = false: chỉ lưu, không vẽ
+    void drawEdge(Edge& edge);
+    int findVertex(const QString& name) const;
+    void selectVertex(int id);
+    QString selectedVerticesText() const;
+    bool isSolving() const;
+    void startSolve(int sourceId, int targetId, const SolverOptions& options, bool allPairsMode);
+    ProgressCallback makeProgressCallback();
+    void clearStreamedVertices();
+    void showStats(const SolverStats& stats);
+    void showResult(int sourceId, int targetId, const ShortestPathResult& result, const QString& algorithmText,
+                    const std::vector<int>& unbounded);
+    // weightOverflowed: tổng thật nhỏ hơn INT_MIN, totalWeight chỉ là giá trị bị ghim
+    void showShortestPath(int sourceId, int targetId, const std::vector<int>& path, int totalWeight,
+                          bool weightOverflowed, bool hasNegativeCycle, const QString& algorithmText);
+    void showNegativeCycle(int sourceId, int targetId, const std::vector<int>& cycle,
+                           const std::vector<int>& unbounded, const QString& algorithmText);
+    QString highlightCycle(const std::vector<int>& cycle, const std::vector<int>& unbounded);
+    void clearOverlays();
+
+    QVector<Vertex> vertices; // Thông tin các đỉnh, chỉ số là id đỉnh trong graph
+    QHash<QString, int> vertexIds; // Tên đỉnh -> id
+    QVector<Edge> edges;  // Danh sách các cạnh, cùng chỉ số với cạnh trong graph
+    GraphEngine graph; // Đồ thị dùng cho thuật toán
+    DynamicShortestPaths shortestPathTree; // Cây đường đi của lần truy vấn gần nhất, sửa dần khi đồ thị đổi
+    ShortestPathCache pathCache; // Kết quả theo đỉnh nguồn, bị xóa khi đồ thị đổi
+    AllPairsShortestPaths allPairs; // Bảng mọi cặp đỉnh khi bật allPairsBox
+    SpatialGrid vertexGrid; // Chỉ mục không gian để chọn đỉnh bằng chuột
+    QVector<int> selectedVertices; // Tối đa hai đỉnh vừa được chọn
     QGraphicsScene *scene;
     QGraphicsView *view;
+    QGraphicsPixmapItem *mapItem = nullptr;
     QPushButton *addEdgeButton;
-    QList<QGraphicsLineItem*> shortestPathLines;
-    QChar vertexCounter;
-    QList<QGraphicsEllipseItem*> coloredVertices;
-    QList<QGraphicsLineItem*> coloredEdges;
+    // Đường đi ngắn nhất gần nhất và chu trình âm gần nhất, mỗi thứ vẽ lại bằng một QPainterPath
+    // cho các đoạn nối và một cho các chấm tròn (item con) để đường gấp khúc không bị tô kín
+    QGraphicsPathItem *pathOverlay;
+    QGraphicsPathItem *pathDots;
+    QGraphicsPathItem *cycleOverlay;
+    QGraphicsPathItem *cycleDots;
     QPushButton *toggleWeightSignButton;
+    QComboBox *solverModeBox; // Chọn chế độ giải
+    QCheckBox *allPairsBox;
+
+    // Lần giải đang chạy trên luồng nền
+    QFutureWatcher<ShortestPathResult> solveWatcher;
+    bool solving = false; // Từ lúc bắt đầu tới khi kết quả được xử lý trên luồng giao diện
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<bool> progressPending{false}; // Còn tín hiệu tiến độ chưa được xử lý
+    int solveSource = -1;
+    int solveTarget = -1;
+    bool solveAllPairs = false;
+    SolverMode solveMode = SolverMode::Auto;
+    // Phần tính thêm trên luồng giải khi có cạnh âm, đọc sau khi lần giải kết thúc
+    struct CycleReport {
+        std::vector<int> unbounded;   // Đỉnh có khoảng cách -vô cùng khi nguồn tới được chu trình âm
+        // Chu trình âm tìm trên toàn đồ thị khi nguồn không tới được chu trình nào
+        // hoặc khi Floyd-Warshall báo có chu trình
+        std::vector<int> graphCycle;
+    };
+    std::shared_ptr<CycleReport> solveCycles;
+    QVector<int> streamedVertices; // Đỉnh đang được tô màu theo tiến độ
+    QVector<char> streamed;
+    QPushButton *findShortestPathButton;
+    QPushButton *cancelButton;
+    QProgressBar *solveProgress;
+
+    // Bảng thống kê của lần giải gần nhất; bộ đếm chỉ có khi dựng với FORDBELLMAN_STATS
+    QDockWidget *statsDock;
+    QLabel *statsLabel;
+    SolverStats lastStats;
 
 };
 
@@ -0,0 +1,316 @@
+#include "graphengine.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Rào chắn đồng bộ các luồng giữa các lượt relax
+class Barrier
+{
+public:
+    explicit Barrier(int count) : threshold(count), waiting(count) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        const unsigned long long phase = generation;
+        if (--waiting == 0) {
+            ++generation;
+            waiting = threshold;
+            condition.notify_all();
+        } else {
+            condition.wait(lock, [&] { return phase != generation; });
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    const int threshold;
+    int waiting;
+    unsigned long long generation = 0;
+};
+
+// Số đỉnh frontier mỗi luồng lấy một lần
+const int ChunkSize = 64;
+
+// Bộ đếm riêng của từng luồng, mỗi phần tử một dòng cache để các luồng không tranh nhau
+struct alignas(64) WorkerCounters {
+    long long attempted = 0;
+    long long succeeded = 0;
+    long long pushes = 0;
+};
+
+// Khoảng cách (32 bit cao) và đỉnh cha (32 bit thấp) gói trong một từ để một lần
+// compare-and-swap ghi cả hai, đỉnh cha luôn khớp với khoảng cách đang lưu
+using PackedState = std::uint64_t;
+
+PackedState packState(int distance, int parent) {
+    return (static_cast<PackedState>(static_cast<std::uint32_t>(distance)) << 32)
+           | static_cast<std::uint32_t>(parent);
+}
+
+int stateDistance(PackedState state) {
+    return static_cast<int>(static_cast<std::uint32_t>(state >> 32));
+}
+
+int stateParent(PackedState state) {
+    return static_cast<int>(static_cast<std::uint32_t>(state));
+}
+
+// Relax theo frontier trên threadCount luồng tới khi frontier rỗng hoặc đủ csr.vertexCount lượt.
+// Trả về một đỉnh còn được cập nhật ở lượt thứ csr.vertexCount (có chu trình âm), -1 nếu hội tụ.
+// progressDistance nhận bản chép khoảng cách mỗi lần báo tiến độ; nullptr nếu khoảng cách
+// không tính từ một đỉnh nguồn thật. Lúc gọi nó phải khớp với state, sau đó mỗi lượt chỉ chép
+// các đỉnh vừa được cập nhật (chính là frontier mới).
+int relaxInParallel(const CsrView &csr, std::vector<std::atomic<PackedState>> &state, std::vector<int> frontier,
+                    int threadCount, const ProgressCallback &progress, int *progressDistance,
+                    SolverStats &stats, bool *cancelled) {
+    (void)stats;  // Không dùng khi tắt FORDBELLMAN_STATS
+    const int vertices = csr.vertexCount;
+    std::vector<std::atomic<char>> queued(vertices);
+    for (int v = 0; v < vertices; ++v)
+        queued[v].store(0, std::memory_order_relaxed);
+
+    // Các luồng lấy từng khối đỉnh của frontier qua con trỏ chung nên luồng rảnh tự nhận việc còn lại
+    std::vector<std::vector<int>> nextFrontier(threadCount);
+    std::atomic<size_t> cursor(0);
+    bool finished = false;
+    Barrier barrier(threadCount);
+    SOLVER_STATS(std::vector<WorkerCounters> counters(threadCount);)
+
+    auto relaxFrontier = [&](int worker) {
+        std::vector<int> &local = nextFrontier[worker];
+        SOLVER_STATS(long long attempted = 0, succeeded = 0;)
+        for (;;) {
+            const size_t begin = cursor.fetch_add(ChunkSize, std::memory_order_relaxed);
+            if (begin >= frontier.size())
+                break;
+            const size_t end = std::min(frontier.size(), begin + ChunkSize);
+            for (size_t i = begin; i < end; ++i) {
+                const int u = frontier[i];
+                const int du = stateDistance(state[u].load(std::memory_order_relaxed));
+                for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+                    const int v = csr.targets[k];
+                    const long long candidate = static_cast<long long>(du) + csr.weights[k];
+                    SOLVER_STATS(++attempted;)
+                    // Cập nhật min bằng compare-and-swap
+                    const PackedState updated = packState(GraphEngine::clampDistance(candidate), u);
+                    PackedState current = state[v].load(std::memory_order_relaxed);
+                    while (candidate < stateDistance(current)) {
+                        if (state[v].compare_exchange_weak(current, updated, std::memory_order_relaxed)) {
+                            SOLVER_STATS(++succeeded;)
+                            if (!queued[v].exchange(1, std::memory_order_relaxed))
+                                local.push_back(v);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        SOLVER_STATS(counters[worker].attempted += attempted;
+                     counters[worker].succeeded += succeeded;
+                     counters[worker].pushes += static_cast<long long>(local.size());)
+    };
+
+    auto workerLoop = [&](int worker) {
+        for (;;) {
+            barrier.wait();  // Chờ bắt đầu lượt
+            if (finished)
+                return;
+            relaxFrontier(worker);
+            barrier.wait();  // Kết thúc lượt
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; ++t)
+        workers.emplace_back(workerLoop, t);
+
+    // Luồng gọi hàm là luồng 0 và điều phối các lượt
+    int witness = -1;
+    int round = 0;
+    while (!frontier.empty()) {
+        // Không có chu trình âm thì mọi khoảng cách hội tụ sau vertices - 1 lượt;
+        // frontier lúc này là các đỉnh còn được cập nhật ở lượt thứ vertices
+        if (round == vertices) {
+            witness = frontier.front();
+            break;
+        }
+        cursor.store(0, std::memory_order_relaxed);
+        barrier.wait();
+        relaxFrontier(0);
+        barrier.wait();
+
+        frontier.clear();
+        for (std::vector<int> &local : nextFrontier) {
+            frontier.insert(frontier.end(), local.begin(), local.end());
+            local.clear();
+        }
+        for (int v : frontier)
+            queued[v].store(0, std::memory_order_relaxed);
+        ++round;
+
+        // Giữa hai lượt các luồng đều đứng chờ, chép khoảng cách ra để báo tiến độ. Đỉnh ngoài
+        // frontier không đổi trong lượt vừa rồi nên bản chép của chúng vẫn đúng
+        if (progress) {
+            if (progressDistance) {
+                for (int v : frontier)
+                    progressDistance[v] = stateDistance(state[v].load(std::memory_order_relaxed));
+            }
+            SolverProgress report;
+            report.round = round;
+            report.totalRounds = vertices;
+            report.distance = progressDistance;
+            if (!progress(report)) {
+                *cancelled = true;
+                break;
+            }
+        }
+    }
+
+    finished = true;
+    barrier.wait();
+    for (std::thread &worker : workers)
+        worker.join();
+
+    SOLVER_STATS(stats.passes += round;
+                 for (const WorkerCounters &worker : counters) {
+                     stats.relaxationsAttempted += worker.attempted;
+                     stats.relaxationsSucceeded += worker.succeeded;
+                     stats.queuePushes += worker.pushes;
+                 })
+    return witness;
+}
+
+// Dưới số cạnh này findNegativeCycle() tự chọn một luồng: chi phí dựng luồng và rào chắn mỗi lượt
+// lớn hơn phần relax được chia
+const int ParallelCycleSearchMinEdges = 1 << 16;
+
+int defaultThreadCount(int threadCount) {
+    return threadCount > 0 ? threadCount : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+} // namespace
+
+ShortestPathResult GraphEngine::parallelBellmanFord(int source, int threadCount,
+                                                    const ProgressCallback &progress) const {
+    buildCsr();
+
+    ShortestPathResult result = initResult(source);
+    result.algorithm = Algorithm::ParallelBellmanFord;
+    if (source < 0 || source >= vertices)
+        return result;
+
+    std::vector<std::atomic<PackedState>> state(vertices);
+    for (int v = 0; v < vertices; ++v)
+        state[v].store(packState(Infinity, -1), std::memory_order_relaxed);
+    state[source].store(packState(0, -1), std::memory_order_relaxed);
+
+    SOLVER_STATS(PhaseClock relaxClock(result.stats, SolverPhase::Relax);)
+    const int witness = relaxInParallel(csr, state, {source}, defaultThreadCount(threadCount), progress,
+                                        result.distance.data(), result.stats, &result.cancelled);
+    for (int v = 0; v < vertices; ++v)
+        result.distance[v] = stateDistance(state[v].load(std::memory_order_relaxed));
+    SOLVER_STATS(relaxClock.stop();)
+
+    if (witness != -1) {
+        // Chu trình âm nằm trên các đỉnh cha được ghi cùng khoảng cách
+        SOLVER_STATS(PhaseClock checkClock(result.stats, SolverPhase::NegativeCycleCheck);)
+        for (int v = 0; v < vertices; ++v)
+            result.previous[v] = stateParent(state[v].load(std::memory_order_relaxed));
+        result.hasNegativeCycle = true;
+        result.negativeCycle = traceNegativeCycle(result.previous.data(), witness);
+        SOLVER_STATS(checkClock.stop();)
+    } else if (!result.cancelled) {
+        SOLVER_STATS(PhaseClock treeClock(result.stats, SolverPhase::PathReconstruction);)
+        buildPredecessorTree(result);
+        SOLVER_STATS(treeClock.stop();)
+    }
+    resolveOverflow(result);
+    return result;
+}
+
+std::vector<int> GraphEngine::findNegativeCycle(int threadCount, const ProgressCallback &progress,
+                                                bool *cancelled) const {
+    if (cancelled)
+        *cancelled = false;
+    if (negativeEdges == 0 || (potentialRevision == revision && !potentialHasNegativeCycle))
+        return std::vector<int>();
+    if (graphCycleRevision == revision)
+        return graphCycle;
+    buildCsr();
+
+    // Đỉnh nguồn ảo nối tới mọi đỉnh bằng cạnh trọng số 0: mọi đỉnh bắt đầu ở khoảng cách 0
+    // và cùng nằm trong frontier đầu tiên
+    std::vector<std::atomic<PackedState>> state(vertices);
+    std::vector<int> frontier(vertices);
+    for (int v = 0; v < vertices; ++v) {
+        state[v].store(packState(0, -1), std::memory_order_relaxed);
+        frontier[v] = v;
+    }
+
+    if (threadCount <= 0 && csr.edgeCount < ParallelCycleSearchMinEdges)
+        threadCount = 1;
+    SolverStats stats;
+    bool stopped = false;
+    const int witness = relaxInParallel(csr, state, std::move(frontier), defaultThreadCount(threadCount),
+                                        progress, nullptr, stats, &stopped);
+    if (cancelled)
+        *cancelled = stopped;
+    if (stopped)
+        return std::vector<int>();
+
+    graphCycle.clear();
+    std::vector<int> previous(vertices);
+    bool pinned = false;
+    for (int v = 0; v < vertices; ++v) {
+        const PackedState packed = state[v].load(std::memory_order_relaxed);
+        previous[v] = stateParent(packed);
+        pinned = pinned || stateDistance(packed) == INT_MIN;
+    }
+    if (witness != -1)
+        graphCycle = traceNegativeCycle(previous.data(), witness);
+    // Hiếm khi cây cha ghi song song không còn khép thành chu trình. Còn khi có đỉnh bị ghim ở
+    // INT_MIN thì frontier có thể tắt dù chu trình âm vẫn còn: đỉnh ghim không đổi giá trị nên
+    // cạnh trọng số 0 đi từ nó không đưa đỉnh nào vào frontier nữa. Cả hai trường hợp đều
+    // quyết định lại bằng Bellman-Ford 64 bit từ mọi đỉnh
+    if (graphCycle.empty() && (witness != -1 || pinned)) {
+        std::vector<int> sources(vertices);
+        for (int v = 0; v < vertices; ++v)
+            sources[v] = v;
+        std::vector<long long> exact;
+        const int exactWitness = exactBellmanFord(sources, exact, previous);
+        if (exactWitness != -1)
+            graphCycle = traceNegativeCycle(previous.data(), exactWitness);
+    }
+    graphCycleRevision = revision;
+    return graphCycle;
+}
+
+void GraphEngine::buildPredecessorTree(ShortestPathResult &result) const {
+    // Dựng cây đường đi theo thứ tự BFS trên các cạnh "chặt" (d[u] + w == d[v]),
+    // không phụ thuộc thứ tự các luồng đã ghi khoảng cách
+    const int *distance = result.distance.data();
+    int *previous = result.previous.data();
+    std::vector<char> visited(vertices, 0);
+    std::vector<int> queue;
+    queue.reserve(vertices);
+    queue.push_back(result.source);
+    visited[result.source] = 1;
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const int u = queue[head];
+        for (int k = csr.offsets[u]; k < csr.offsets[u + 1]; ++k) {
+            const int v = csr.targets[k];
+            if (!visited[v] && static_cast<long long>(distance[u]) + csr.weights[k] == distance[v]) {
+                visited[v] = 1;
+                previous[v] = u;
+                queue.push_back(v);
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#include "relaxkernel.h"
+#include <climits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define RELAXKERNEL_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+bool relaxEdgesScalar(const int *from, const int *to, const int *weight, int count,
+                      int *distance, int *previous) {
+    bool changed = false;
+    for (int i = 0; i < count; ++i) {
+        const int du = distance[from[i]];
+        if (du == INT_MAX)
+            continue;
+        // So sánh bằng long long: tổng dưới INT_MIN vẫn là cập nhật, chỉ giá trị lưu bị ghim
+        const long long candidate = static_cast<long long>(du) + weight[i];
+        if (candidate < distance[to[i]]) {
+            distance[to[i]] = candidate < INT_MIN ? INT_MIN : static_cast<int>(candidate);
+            previous[to[i]] = from[i];
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+#ifdef RELAXKERNEL_HAS_AVX2
+
+__attribute__((target("avx2")))
+bool relaxEdgesAvx2(const int *from, const int *to, const int *weight, int count,
+                    int *distance, int *previous) {
+    const __m256i infinity = _mm256_set1_epi32(INT_MAX);
+    alignas(32) int candidates[8];
+    bool changed = false;
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i u = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(from + i));
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(to + i));
+        const __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weight + i));
+        const __m256i du = _mm256_i32gather_epi32(distance, u, 4);
+        const __m256i dv = _mm256_i32gather_epi32(distance, v, 4);
+
+        // Cộng bão hòa: tràn khi hai toán hạng cùng dấu mà tổng khác dấu
+        __m256i sum = _mm256_add_epi32(du, w);
+        const __m256i overflow = _mm256_srai_epi32(
+            _mm256_and_si256(_mm256_xor_si256(du, sum), _mm256_xor_si256(w, sum)), 31);
+        const __m256i saturated = _mm256_xor_si256(_mm256_srai_epi32(du, 31), infinity);
+        sum = _mm256_blendv_epi8(sum, saturated, overflow);
+
+        // Tràn xuống dưới INT_MIN (du âm) nghĩa là tổng thật nhỏ hơn mọi dv, kể cả dv đã bị ghim
+        // ở INT_MIN; phải tính là cập nhật, nếu không chu trình âm bị ghim sẽ trông như đã hội tụ
+        const __m256i underflow = _mm256_and_si256(overflow, _mm256_srai_epi32(du, 31));
+
+        // Chỉ giữ các làn có du hữu hạn và tổng nhỏ hơn dv
+        const __m256i better = _mm256_andnot_si256(
+            _mm256_cmpeq_epi32(du, infinity), _mm256_or_si256(_mm256_cmpgt_epi32(dv, sum), underflow));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(better));
+        if (!mask)
+            continue;
+        const int underflowMask = _mm256_movemask_ps(_mm256_castsi256_ps(underflow));
+
+        // Ghi ngược từng làn, so sánh lại vì nhiều làn có thể cùng đỉnh đích
+        _mm256_store_si256(reinterpret_cast<__m256i *>(candidates), sum);
+        while (mask) {
+            const int lane = __builtin_ctz(mask);
+            mask &= mask - 1;
+            const int target = to[i + lane];
+            if (candidates[lane] < distance[target] || (underflowMask >> lane & 1)) {
+                distance[target] = candidates[lane];
+                previous[target] = from[i + lane];
+                changed = true;
+            }
+        }
+    }
+
+    if (relaxEdgesScalar(from + i, to + i, weight + i, count - i, distance, previous))
+        changed = true;
+    return changed;
+}
+
+bool cpuSupportsAvx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+bool relaxEdgesAvx2(const int *from, const int *to, const int *weight, int count,
+                    int *distance, int *previous) {
+    return relaxEdgesScalar(from, to, weight, count, distance, previous);
+}
+
+bool cpuSupportsAvx2() {
+    return false;
+}
+
+#endif
+
+RelaxKernel selectRelaxKernel() {
+    static const RelaxKernel kernel = cpuSupportsAvx2() ? relaxEdgesAvx2 : relaxEdgesScalar;
+    return kernel;
+}
+
+const char *relaxKernelName(RelaxKernel kernel) {
+    if (kernel == relaxEdgesAvx2 && cpuSupportsAvx2())
+        return "AVX2";
+    return "scalar";
+}
@@ -0,0 +1,20 @@
+#ifndef RELAXKERNEL_H
+#define RELAXKERNEL_H
+
+// Nhân relax một lượt trên danh sách cạnh dạng SoA (from[], to[], weight[]).
+// Cộng bão hòa thay cho kiểm tra tràn số; đỉnh chưa tới được (INT_MAX) bị loại bằng mặt nạ.
+// Tổng tràn xuống dưới INT_MIN được ghim ở INT_MIN nhưng vẫn tính là cập nhật.
+// Trả về true nếu có ít nhất một khoảng cách được cập nhật.
+using RelaxKernel = bool (*)(const int *from, const int *to, const int *weight, int count,
+                             int *distance, int *previous);
+
+bool relaxEdgesScalar(const int *from, const int *to, const int *weight, int count,
+                      int *distance, int *previous);
+bool relaxEdgesAvx2(const int *from, const int *to, const int *weight, int count,
+                    int *distance, int *previous);
+
+bool cpuSupportsAvx2();
+RelaxKernel selectRelaxKernel();  // Chọn nhân tốt nhất theo CPUID lúc chạy
+const char *relaxKernelName(RelaxKernel kernel);
+
+#endif // RELAXKERNEL_H
@@ -0,0 +1,51 @@
+#include "shortestpathcache.h"
+
+ShortestPathCache::ShortestPathCache(const GraphEngine &graph, int capacity)
+    : graph(graph), capacity(capacity > 0 ? capacity : 1), cachedGeneration(graph.generation())
+{
+}
+
+void ShortestPathCache::clear() {
+    entries.clear();
+    index.clear();
+    cachedGeneration = graph.generation();
+}
+
+void ShortestPathCache::dropIfStale() {
+    if (cachedGeneration != graph.generation())
+        clear();
+}
+
+const ShortestPathResult *ShortestPathCache::find(int source) {
+    dropIfStale();
+    auto it = index.find(source);
+    if (it == index.end()) {
+        ++misses;
+        return nullptr;
+    }
+    ++hits;
+    entries.splice(entries.begin(), entries, it->second);
+    return &entries.front();
+}
+
+const ShortestPathResult &ShortestPathCache::query(int source, const SolverOptions &options) {
+    if (const ShortestPathResult *cached = find(source))
+        return *cached;
+    return insert(graph.shortestPaths(source, options));
+}
+
+const ShortestPathResult &ShortestPathCache::insert(const ShortestPathResult &result) {
+    dropIfStale();
+    auto it = index.find(result.source);
+    if (it != index.end()) {
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    entries.push_front(result);
+    index[result.source] = entries.begin();
+    if (static_cast<int>(entries.size()) > capacity) {
+        index.erase(entries.back().source);
+        entries.pop_back();
+    }
+    return entries.front();
+}
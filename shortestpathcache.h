@@ -0,0 +1,40 @@
+#ifndef SHORTESTPATHCACHE_H
+#define SHORTESTPATHCACHE_H
+
+#include "graphengine.h"
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+// Bộ nhớ đệm kết quả theo đỉnh nguồn (LRU). Toàn bộ bị loại bỏ khi
+// generation() của đồ thị thay đổi, nên truy vấn lặp lại trên đồ thị không đổi
+// chỉ còn tốn thời gian lần theo đường đi.
+class ShortestPathCache
+{
+public:
+    explicit ShortestPathCache(const GraphEngine &graph, int capacity = 32);
+
+    // Kết quả đã lưu cho source, nullptr nếu chưa có hoặc đồ thị đã đổi
+    const ShortestPathResult *find(int source);
+    // Trả về kết quả đã lưu hoặc tính mới rồi lưu lại
+    const ShortestPathResult &query(int source, const SolverOptions &options = SolverOptions());
+    const ShortestPathResult &insert(const ShortestPathResult &result);
+    void clear();
+
+    int size() const { return static_cast<int>(entries.size()); }
+    long long hitCount() const { return hits; }
+    long long missCount() const { return misses; }
+
+private:
+    void dropIfStale();
+
+    const GraphEngine &graph;
+    int capacity;
+    std::uint64_t cachedGeneration = 0;
+    std::list<ShortestPathResult> entries;  // Mới dùng nhất ở đầu
+    std::unordered_map<int, std::list<ShortestPathResult>::iterator> index;
+    long long hits = 0;
+    long long misses = 0;
+};
+
+#endif // SHORTESTPATHCACHE_H
@@ -0,0 +1,109 @@
+#include "solverstats.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Đánh số các luồng theo thứ tự lần đầu đo, gọn hơn id của hệ điều hành
+int currentThread() {
+    static std::atomic<int> nextThread(0);
+    thread_local int thread = nextThread.fetch_add(1);
+    return thread;
+}
+
+} // namespace
+
+const char *solverPhaseName(SolverPhase phase) {
+    switch (phase) {
+    case SolverPhase::Init: return "init";
+    case SolverPhase::Potential: return "potential";
+    case SolverPhase::Relax: return "relax";
+    case SolverPhase::NegativeCycleCheck: return "negative-cycle-check";
+    case SolverPhase::PathReconstruction: return "path-reconstruction";
+    }
+    return "";
+}
+
+std::int64_t SolverStats::phaseDuration(SolverPhase phase) const {
+    std::int64_t total = 0;
+    for (const PhaseTiming &timing : phases) {
+        if (timing.phase == phase)
+            total += timing.duration;
+    }
+    return total;
+}
+
+void SolverStats::add(const SolverStats &other) {
+    passes += other.passes;
+    relaxationsAttempted += other.relaxationsAttempted;
+    relaxationsSucceeded += other.relaxationsSucceeded;
+    queuePushes += other.queuePushes;
+    phases.insert(phases.end(), other.phases.begin(), other.phases.end());
+}
+
+PhaseClock::PhaseClock(SolverStats &stats, SolverPhase phase)
+    : stats(stats)
+{
+    timing.phase = phase;
+    timing.thread = currentThread();
+    timing.start = now();
+}
+
+void PhaseClock::stop() {
+    timing.duration = now() - timing.start;
+    stats.phases.push_back(timing);
+}
+
+bool writeChromeTrace(const std::string &path, const std::vector<SolverStats> &runs, std::string *error) {
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        *error = "Không tạo được file " + path;
+        return false;
+    }
+
+    // Mốc thời gian tính từ pha sớm nhất để số trong file nhỏ và dễ đọc
+    std::int64_t origin = INT64_MAX;
+    for (const SolverStats &stats : runs) {
+        for (const PhaseTiming &timing : stats.phases)
+            origin = std::min(origin, timing.start);
+    }
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    bool first = true;
+    for (size_t run = 0; run < runs.size(); ++run) {
+        const SolverStats &stats = runs[run];
+        for (const PhaseTiming &timing : stats.phases) {
+            // Trace event đo bằng micro giây
+            std::fprintf(file,
+                         "%s\n{\"name\":\"%s\",\"cat\":\"solver\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                         "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"run\":%zu}}",
+                         first ? "" : ",", solverPhaseName(timing.phase), timing.thread,
+                         (timing.start - origin) / 1000.0, timing.duration / 1000.0, run);
+            first = false;
+        }
+        // Bộ đếm của cả lần giải gắn vào cuối pha cuối cùng
+        if (!stats.phases.empty()) {
+            const PhaseTiming &last = stats.phases.back();
+            std::fprintf(file,
+                         ",\n{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+                         "\"args\":{\"passes\":%lld,\"attempted\":%lld,\"succeeded\":%lld,\"pushes\":%lld}}",
+                         last.thread, (last.start + last.duration - origin) / 1000.0, stats.passes,
+                         stats.relaxationsAttempted, stats.relaxationsSucceeded, stats.queuePushes);
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+
+    const bool ok = std::ferror(file) == 0;
+    if (std::fclose(file) != 0 || !ok) {
+        *error = "Không ghi được file " + path;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+#ifndef SOLVERSTATS_H
+#define SOLVERSTATS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Bộ đếm chỉ được biên dịch vào solver khi định nghĩa FORDBELLMAN_STATS
+// (tùy chọn CMake cùng tên). Khi tắt, SOLVER_STATS(...) biến mất hoàn toàn và
+// SolverStats luôn bằng 0, nên vòng lặp relax không tốn thêm lệnh nào.
+#ifdef FORDBELLMAN_STATS
+#define SOLVER_STATS(...) __VA_ARGS__
+#else
+#define SOLVER_STATS(...)
+#endif
+
+// Các pha của một lần giải
+enum class SolverPhase {
+    Init,               // Cấp phát và khởi tạo mảng khoảng cách
+    Potential,          // Bellman-Ford từ đỉnh nguồn ảo để tính thế năng Johnson
+    Relax,
+    NegativeCycleCheck,
+    PathReconstruction
+};
+
+const char *solverPhaseName(SolverPhase phase);
+
+struct PhaseTiming {
+    SolverPhase phase = SolverPhase::Init;
+    int thread = 0;              // Số thứ tự luồng, chỉ để phân biệt trong trace
+    std::int64_t start = 0;      // steady_clock, nano giây
+    std::int64_t duration = 0;   // Nano giây
+};
+
+struct SolverStats {
+    long long passes = 0;                // Số lượt relax (SPFA: mỗi n đỉnh lấy ra tính một lượt)
+    long long relaxationsAttempted = 0;  // Số cạnh được xét
+    long long relaxationsSucceeded = 0;  // Số lần khoảng cách giảm (nhân SIMD không đếm)
+    long long queuePushes = 0;           // Số lần đưa đỉnh vào hàng đợi, heap hoặc frontier
+    std::vector<PhaseTiming> phases;
+
+    std::int64_t phaseDuration(SolverPhase phase) const;  // Tổng nano giây của một pha
+    void add(const SolverStats &other);  // Cộng dồn bộ đếm và nối các pha
+};
+
+// Đo một pha từ lúc tạo tới khi gọi stop(); không dùng hàm hủy để kết quả
+// không phụ thuộc việc trình biên dịch có tối ưu sao chép giá trị trả về hay không.
+class PhaseClock
+{
+public:
+    PhaseClock(SolverStats &stats, SolverPhase phase);
+    void stop();
+
+private:
+    SolverStats &stats;
+    PhaseTiming timing;
+};
+
+// Ghi các pha của nhiều lần giải ra file JSON dạng Chrome trace event,
+// mở bằng chrome://tracing hoặc ui.perfetto.dev. Khi lỗi trả về false và ghi lý do vào error.
+bool writeChromeTrace(const std::string &path, const std::vector<SolverStats> &runs, std::string *error);
+
+#endif // SOLVERSTATS_H
@@ -0,0 +1,52 @@
+#include "spatialgrid.h"
+#include <cmath>
+#include <cstdint>
+
+SpatialGrid::SpatialGrid(double cellSize)
+    : cellSize(cellSize)
+{
+}
+
+void SpatialGrid::clear() {
+    cells.clear();
+    count = 0;
+}
+
+int SpatialGrid::cellCoordinate(double value) const {
+    return static_cast<int>(std::floor(value / cellSize));
+}
+
+unsigned long long SpatialGrid::cellKey(int cx, int cy) {
+    // Dịch trên số không dấu: tọa độ ô âm (nhấp chuột ở vùng scene âm) không gây hành vi không xác định
+    return (static_cast<unsigned long long>(static_cast<std::uint32_t>(cx)) << 32) | static_cast<std::uint32_t>(cy);
+}
+
+void SpatialGrid::insert(int id, double x, double y) {
+    cells[cellKey(cellCoordinate(x), cellCoordinate(y))].push_back({id, x, y});
+    ++count;
+}
+
+int SpatialGrid::nearest(double x, double y, double maxDistance) const {
+    const int cx = cellCoordinate(x);
+    const int cy = cellCoordinate(y);
+    const int radius = static_cast<int>(std::ceil(maxDistance / cellSize));
+
+    int best = -1;
+    double bestDistance = maxDistance * maxDistance;
+    // Chỉ xét các ô nằm trong bán kính tìm kiếm
+    for (int dx = -radius; dx <= radius; ++dx) {
+        for (int dy = -radius; dy <= radius; ++dy) {
+            auto cell = cells.find(cellKey(cx + dx, cy + dy));
+            if (cell == cells.end())
+                continue;
+            for (const Point &point : cell->second) {
+                const double distance = (point.x - x) * (point.x - x) + (point.y - y) * (point.y - y);
+                if (distance <= bestDistance) {
+                    bestDistance = distance;
+                    best = point.id;
+                }
+            }
+        }
+    }
+    return best;
+}
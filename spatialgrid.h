@@ -0,0 +1,35 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <unordered_map>
+#include <vector>
+
+// Lưới đều chia mặt phẳng thành các ô vuông để tìm đỉnh gần nhất
+// chỉ trong vài ô lân cận thay vì duyệt toàn bộ các đỉnh.
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(double cellSize = 32.0);
+
+    void clear();
+    void insert(int id, double x, double y);
+    // Đỉnh gần (x, y) nhất trong bán kính maxDistance, -1 nếu không có
+    int nearest(double x, double y, double maxDistance) const;
+    int size() const { return count; }
+
+private:
+    struct Point {
+        int id;
+        double x;
+        double y;
+    };
+
+    int cellCoordinate(double value) const;
+    static unsigned long long cellKey(int cx, int cy);
+
+    double cellSize;
+    int count = 0;
+    std::unordered_map<unsigned long long, std::vector<Point>> cells;
+};
+
+#endif // SPATIALGRID_H
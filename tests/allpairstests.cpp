@@ -0,0 +1,97 @@
+// Floyd-Warshall chia khối phải khớp với Bellman-Ford chạy từ mọi đỉnh nguồn.
+#include "allpairs.h"
+#include "testgraphs.h"
+#include <gtest/gtest.h>
+#include <climits>
+#include <vector>
+
+namespace {
+
+TEST(AllPairsShortestPaths, MatchBellmanFordFromEverySource) {
+    std::mt19937 rng(99);
+    for (int trial = 0; trial < 30; ++trial) {
+        GraphEngine graph;
+        // Vượt BlockSize để có nhiều khối chạy song song
+        const int n = 2 + static_cast<int>(rng() % 150);
+        randomGraph(graph, n, n * 3, trial % 3 == 2, rng);
+        AllPairsShortestPaths allPairs;
+        ASSERT_TRUE(allPairs.compute(graph, 1 + trial % 4));
+
+        SCOPED_TRACE(testing::Message() << "lần " << trial);
+        bool anySource = false;
+        std::vector<ShortestPathResult> expected;
+        for (int s = 0; s < n; ++s) {
+            expected.push_back(graph.bellmanFord(s, false));
+            anySource = anySource || expected.back().hasNegativeCycle;
+        }
+        ASSERT_EQ(allPairs.hasNegativeCycle(), anySource);
+        if (anySource)
+            continue;
+        for (int s = 0; s < n; ++s) {
+            for (int t = 0; t < n; ++t) {
+                ASSERT_EQ(allPairs.distance(s, t), expected[s].distance[t]) << s << " -> " << t;
+                const std::vector<int> path = allPairs.path(s, t);
+                if (expected[s].reachable(t))
+                    EXPECT_EQ(walkWeight(graph, path, false), allPairs.distance(s, t)) << s << " -> " << t;
+                else
+                    EXPECT_TRUE(path.empty());
+            }
+        }
+    }
+}
+
+TEST(AllPairsShortestPaths, LargeWeightsMatchReference) {
+    // Chỉ một cạnh +2e9 mỗi đồ thị để không tổng đoạn nào chạm INT_MAX: Floyd-Warshall ghép đoạn
+    // theo thứ tự khác Bellman-Ford nên quy ước "từ INT_MAX là không tới được" không so sánh được
+    const int weights[] = {INT_MIN, -2000000000, -1000000000, -7, 0, 5};
+    std::mt19937 rng(2009);
+    int withCycle = 0;
+    int overflowed = 0;
+    for (int trial = 0; trial < 200; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 8);
+        for (int v = 0; v < n; ++v)
+            graph.addVertex();
+        const bool acyclic = trial % 2 == 0;
+        for (int e = 0; e < n + static_cast<int>(rng() % n); ++e) {
+            int u = static_cast<int>(rng() % n);
+            int v = static_cast<int>(rng() % n);
+            if (acyclic && u >= v)
+                continue;
+            graph.addEdge(u, v, weights[rng() % (sizeof(weights) / sizeof(weights[0]))]);
+        }
+        graph.addEdge(static_cast<int>(rng() % n), static_cast<int>(rng() % n), 2000000000);
+        AllPairsShortestPaths allPairs;
+        ASSERT_TRUE(allPairs.compute(graph, 1 + trial % 4));
+
+        SCOPED_TRACE(testing::Message() << "lần " << trial);
+        std::vector<ReferencePaths> expected;
+        bool anyCycle = false;
+        bool anyOverflow = false;
+        for (int s = 0; s < n; ++s) {
+            expected.push_back(referencePaths(graph, s));
+            anyCycle = anyCycle || expected.back().hasNegativeCycle;
+            anyOverflow = anyOverflow || expected.back().overflowed;
+        }
+        withCycle += anyCycle;
+        ASSERT_EQ(allPairs.hasNegativeCycle(), anyCycle);
+        if (anyCycle)
+            continue;
+        overflowed += anyOverflow;
+        EXPECT_EQ(allPairs.overflowed(), anyOverflow);
+        for (int s = 0; s < n; ++s) {
+            for (int t = 0; t < n; ++t) {
+                const long long d = expected[s].distance[t];
+                ASSERT_EQ(allPairs.distance(s, t), d == LLONG_MAX ? GraphEngine::Infinity : GraphEngine::clampDistance(d))
+                    << s << " -> " << t;
+                if (d != LLONG_MAX) {
+                    EXPECT_EQ(walkWeight(graph, allPairs.path(s, t), false), d) << s << " -> " << t;
+                }
+            }
+        }
+    }
+    EXPECT_GT(withCycle, 10);
+    EXPECT_GT(overflowed, 10);
+}
+
+} // namespace
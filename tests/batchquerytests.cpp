@@ -0,0 +1,98 @@
+// Trả lời truy vấn hàng loạt phải khớp với Bellman-Ford 64 bit cho từng cặp đỉnh, và file truy vấn
+// có đỉnh ngoài đồ thị phải bị từ chối.
+#include "batchquery.h"
+#include "graphio.h"
+#include "testgraphs.h"
+#include <gtest/gtest.h>
+#include <climits>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+TEST(BatchQueries, MatchReferencePerTarget) {
+    const SolverMode modes[] = {
+        SolverMode::Auto, SolverMode::BellmanFord, SolverMode::Spfa,
+        SolverMode::Parallel, SolverMode::Vectorized
+    };
+    std::mt19937 rng(1212);
+    int boundedWithCycle = 0;
+    for (int trial = 0; trial < 100; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 30);
+        if (trial % 2 == 0)
+            randomGraph(graph, n, n * 2, true, rng);
+        else
+            largeWeightGraph(graph, n, n + static_cast<int>(rng() % (2 * n)), false, rng);
+
+        // Mọi cặp từ vài đỉnh nguồn, thêm một truy vấn có nguồn ngoài đồ thị
+        std::vector<PathQuery> queries;
+        for (int i = 0; i < 3; ++i) {
+            const int source = static_cast<int>(rng() % n);
+            for (int target = 0; target < n; ++target)
+                queries.push_back({source, target});
+        }
+        queries.push_back({n, 0});
+
+        for (SolverMode mode : modes) {
+            SolverOptions options;
+            options.mode = mode;
+            SCOPED_TRACE(testing::Message() << "lần " << trial << ", chế độ " << static_cast<int>(mode));
+            const std::vector<PathAnswer> answers = answerQueries(graph, queries, options, 1 + trial % 3);
+            ASSERT_EQ(answers.size(), queries.size());
+            for (size_t i = 0; i + 1 < queries.size(); ++i) {
+                const PathAnswer &answer = answers[i];
+                const ReferencePaths expected = referencePaths(graph, answer.source);
+                const int target = answer.target;
+                SCOPED_TRACE(testing::Message() << answer.source << " -> " << target);
+                ASSERT_EQ(answer.hasNegativeCycle, expected.unbounded[target] != 0);
+                if (answer.hasNegativeCycle)
+                    continue;
+                boundedWithCycle += expected.hasNegativeCycle && expected.distance[target] != LLONG_MAX;
+                if (expected.distance[target] == LLONG_MAX) {
+                    EXPECT_EQ(answer.distance, GraphEngine::Infinity);
+                    EXPECT_TRUE(answer.path.empty());
+                    continue;
+                }
+                EXPECT_EQ(answer.distance, GraphEngine::clampDistance(expected.distance[target]));
+                EXPECT_EQ(answer.overflowed, expected.distance[target] < INT_MIN);
+                EXPECT_EQ(walkWeight(graph, answer.path, false), expected.distance[target]);
+            }
+            EXPECT_TRUE(answers.back().path.empty());
+            EXPECT_FALSE(answers.back().hasNegativeCycle);
+        }
+    }
+    // Phải có đích vẫn trả lời được dù nguồn tới được chu trình âm
+    EXPECT_GT(boundedWithCycle, 50);
+}
+
+TEST(BatchQueries, LoadRejectsVerticesOutsideGraph) {
+    const std::string path = testing::TempDir() + "queries.txt";
+    auto load = [&](const char *contents, int firstVertex, std::vector<PathQuery> &queries, std::string &error) {
+        FILE *file = std::fopen(path.c_str(), "wb");
+        std::fputs(contents, file);
+        std::fclose(file);
+        return loadQueries(path, queries, firstVertex, 2, &error);
+    };
+    std::vector<PathQuery> queries;
+    std::string error;
+
+    ASSERT_TRUE(load("c hai truy vấn\nq 1 2\n2 1\n", 1, queries, error)) << error;
+    ASSERT_EQ(queries.size(), 2u);
+    EXPECT_EQ(queries[0].source, 0);
+    EXPECT_EQ(queries[0].target, 1);
+    EXPECT_EQ(queries[1].source, 1);
+    EXPECT_EQ(queries[1].target, 0);
+
+    EXPECT_FALSE(load("1 2\n1 3\n", 1, queries, error));
+    EXPECT_EQ(error.rfind("Dòng 2", 0), 0u) << error;
+    EXPECT_FALSE(load("3 1\n", 1, queries, error));
+    EXPECT_EQ(error.rfind("Dòng 1", 0), 0u) << error;
+    EXPECT_FALSE(load("0 1\n", 1, queries, error));
+    EXPECT_FALSE(load("0 2\n", 0, queries, error));
+    EXPECT_TRUE(load("0 1\n", 0, queries, error)) << error;
+    std::remove(path.c_str());
+}
+
+} // namespace
@@ -0,0 +1,90 @@
+// Cây sửa cục bộ phải luôn khớp với một lần giải lại từ đầu sau mỗi lần sửa đồ thị.
+#include "dynamicshortestpaths.h"
+#include "testgraphs.h"
+#include <gtest/gtest.h>
+#include <climits>
+#include <vector>
+
+namespace {
+
+TEST(DynamicShortestPaths, RepairsMatchFullSolve) {
+    std::mt19937 rng(2024);
+    for (int trial = 0; trial < 40; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 40);
+        randomGraph(graph, n, n * 2, false, rng);
+        const int source = static_cast<int>(rng() % n);
+        DynamicShortestPaths tree(graph);
+        tree.reset(source);
+
+        for (int step = 0; step < 60; ++step) {
+            const int kind = static_cast<int>(rng() % 4);
+            if (kind == 0) {
+                graph.addVertex();
+                tree.vertexAdded();
+            } else if (kind == 1 || graph.edgeCount() == 0) {
+                const int u = static_cast<int>(rng() % graph.vertexCount());
+                const int v = static_cast<int>(rng() % graph.vertexCount());
+                tree.edgeAdded(graph.addEdge(u, v, static_cast<int>(rng() % 60) - 15));
+            } else {
+                const int edge = static_cast<int>(rng() % graph.edgeCount());
+                const int oldWeight = graph.edgeWeight(edge);
+                graph.setEdgeWeight(edge, oldWeight + static_cast<int>(rng() % 41) - 20);
+                tree.edgeWeightChanged(edge, oldWeight);
+            }
+
+            SCOPED_TRACE(testing::Message() << "lần " << trial << ", bước " << step);
+            const ShortestPathResult expected = graph.bellmanFord(source, false);
+            if (expected.hasNegativeCycle) {
+                // Cây không được giữ khoảng cách sai khi đã có chu trình âm
+                EXPECT_TRUE(!tree.isValid() || tree.result().hasNegativeCycle);
+                tree.reset(source);
+                EXPECT_TRUE(tree.result().hasNegativeCycle);
+                continue;
+            }
+            if (!tree.isValid()) {
+                // Chỉ được mất hiệu lực vì chu trình âm đã bị sửa mất ở bước trước
+                EXPECT_TRUE(tree.result().hasNegativeCycle);
+                tree.reset(source);
+            }
+            ASSERT_TRUE(tree.isValid());
+            EXPECT_EQ(tree.result().distance, expected.distance);
+            expectConsistentPaths(graph, tree.result());
+        }
+    }
+}
+
+TEST(DynamicShortestPaths, LargeWeightsMatchReference) {
+    // Sửa cây không được ghim ở INT_MIN rồi so sánh tiếp trên giá trị ghim
+    const int weights[] = {INT_MIN, -2000000000, -1000000000, -7, 0, 5, 1000000000, 2000000000, INT_MAX};
+    std::mt19937 rng(2008);
+    for (int trial = 0; trial < 100; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 8);
+        largeWeightGraph(graph, n, n, true, rng);
+        const int source = static_cast<int>(rng() % n);
+        DynamicShortestPaths tree(graph);
+        tree.reset(source);
+
+        for (int step = 0; step < 20; ++step) {
+            const int weight = weights[rng() % (sizeof(weights) / sizeof(weights[0]))];
+            if (step % 2 == 0 || graph.edgeCount() == 0) {
+                const int u = static_cast<int>(rng() % n);
+                const int v = static_cast<int>(rng() % n);
+                tree.edgeAdded(graph.addEdge(u, v, weight));
+            } else {
+                const int edge = static_cast<int>(rng() % graph.edgeCount());
+                const int oldWeight = graph.edgeWeight(edge);
+                graph.setEdgeWeight(edge, weight);
+                tree.edgeWeightChanged(edge, oldWeight);
+            }
+
+            SCOPED_TRACE(testing::Message() << "lần " << trial << ", bước " << step);
+            if (!tree.isValid())
+                tree.reset(source);
+            expectMatchesReference(graph, tree.result(), referencePaths(graph, source));
+        }
+    }
+}
+
+} // namespace
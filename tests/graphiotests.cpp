@@ -0,0 +1,134 @@
+// Đọc/ghi đồ thị qua các định dạng file, và file nhị phân hỏng phải bị từ chối thay vì đọc tràn.
+#include "graphio.h"
+#include "testgraphs.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+std::string tempPath(const char *name) {
+    return testing::TempDir() + name;
+}
+
+void writeFile(const std::string &path, const std::vector<char> &bytes) {
+    FILE *file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fwrite(bytes.data(), 1, bytes.size(), file), bytes.size());
+    std::fclose(file);
+}
+
+template <typename T>
+void append(std::vector<char> &bytes, T value) {
+    const char *raw = reinterpret_cast<const char *>(&value);
+    bytes.insert(bytes.end(), raw, raw + sizeof(value));
+}
+
+// File .fbg dựng tay: phần đầu 32 byte rồi các mảng int32 liền nhau
+std::vector<char> binaryFile(std::int32_t vertexCount, std::int32_t edgeCount, const std::vector<std::int32_t> &arrays) {
+    std::vector<char> bytes = {'F', 'B', 'C', 'S', 'R', 0, 0, 0};
+    append<std::uint32_t>(bytes, 1);  // Phiên bản
+    append<std::uint32_t>(bytes, 0);  // Không có tọa độ
+    append(bytes, vertexCount);
+    append(bytes, edgeCount);
+    append<std::uint64_t>(bytes, 0);
+    for (std::int32_t value : arrays)
+        append(bytes, value);
+    return bytes;
+}
+
+std::vector<std::tuple<int, int, int>> sortedEdges(const GraphEngine &graph) {
+    std::vector<std::tuple<int, int, int>> edges;
+    for (int e = 0; e < graph.edgeCount(); ++e)
+        edges.emplace_back(graph.edgeSource(e), graph.edgeTarget(e), graph.edgeWeight(e));
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+TEST(GraphIo, RoundTripsEveryFormat) {
+    std::mt19937 rng(7007);
+    GraphEngine graph;
+    largeWeightGraph(graph, 30, 120, false, rng);
+    std::vector<float> positions;
+    for (int v = 0; v < graph.vertexCount(); ++v) {
+        positions.push_back(static_cast<float>(v) * 1.5f);
+        positions.push_back(-static_cast<float>(v));
+    }
+
+    for (const char *name : {"roundtrip.gr", "roundtrip.csv", "roundtrip.fbg"}) {
+        SCOPED_TRACE(name);
+        const std::string path = tempPath(name);
+        std::string error;
+        ASSERT_TRUE(saveGraph(path, graph, &positions, &error)) << error;
+        GraphEngine loaded;
+        std::vector<float> loadedPositions;
+        ASSERT_TRUE(loadGraph(path, loaded, &loadedPositions, &error)) << error;
+        EXPECT_EQ(loaded.vertexCount(), graph.vertexCount());
+        EXPECT_EQ(sortedEdges(loaded), sortedEdges(graph));
+        // Chỉ định dạng nhị phân giữ tọa độ
+        if (graphFormatFromPath(path) == GraphFormat::Binary)
+            EXPECT_EQ(loadedPositions, positions);
+        else
+            EXPECT_TRUE(loadedPositions.empty());
+        std::remove(path.c_str());
+    }
+}
+
+TEST(GraphIo, RejectsCorruptedBinaryHeader) {
+    const std::string path = tempPath("header.fbg");
+    // Đồ thị hợp lệ 2 đỉnh, 1 cạnh 0 -> 1 trọng số 5
+    const std::vector<std::int32_t> arrays = {0, 1, 1, 0, 1, 5};
+    GraphEngine graph;
+    std::string error;
+
+    writeFile(path, binaryFile(2, 1, arrays));
+    ASSERT_TRUE(loadBinary(path, graph, nullptr, &error)) << error;
+    EXPECT_EQ(sortedEdges(graph), (std::vector<std::tuple<int, int, int>>{std::make_tuple(0, 1, 5)}));
+
+    std::vector<char> badMagic = binaryFile(2, 1, arrays);
+    badMagic[0] = 'X';
+    writeFile(path, badMagic);
+    EXPECT_FALSE(loadBinary(path, graph, nullptr, &error));
+
+    writeFile(path, binaryFile(-1, 1, arrays));
+    EXPECT_FALSE(loadBinary(path, graph, nullptr, &error));
+    writeFile(path, binaryFile(2, 2, arrays));  // Kích thước không khớp số cạnh
+    EXPECT_FALSE(loadBinary(path, graph, nullptr, &error));
+    writeFile(path, std::vector<char>(10, 0));  // Ngắn hơn phần đầu
+    EXPECT_FALSE(loadBinary(path, graph, nullptr, &error));
+    std::remove(path.c_str());
+}
+
+TEST(GraphIo, RejectsOffsetsOutOfRange) {
+    const std::string path = tempPath("offsets.fbg");
+    GraphEngine graph;
+    std::string error;
+
+    // Offset giữa lớn hơn số cạnh: trước đây được dùng làm cận vòng lặp trước khi bị kiểm tra,
+    // và cạnh 0 -> 0 trọng số 0 khiến vòng lặp đọc tiếp các số 0 ra ngoài file
+    writeFile(path, binaryFile(2, 1, {0, 100000000, 1, 0, 0, 0}));
+    EXPECT_FALSE(loadBinary(path, graph, nullptr, &error));
+    EXPECT_NE(error.find("offsets"), std::string::npos) << error;
+
+    for (const std::vector<std::int32_t> &offsets : {std::vector<std::int32_t>{0, -5, 1},
+                                                     std::vector<std::int32_t>{1, 1, 1},
+                                                     std::vector<std::int32_t>{0, 1, 0}}) {
+        std::vector<std::int32_t> arrays = offsets;
+        arrays.insert(arrays.end(), {0, 1, 5});
+        writeFile(path, binaryFile(2, 1, arrays));
+        EXPECT_FALSE(loadBinary(path, graph, nullptr, &error));
+        EXPECT_NE(error.find("offsets"), std::string::npos) << error;
+    }
+    // Offsets đúng nhưng cạnh sai đỉnh nguồn hoặc đích nằm ngoài đồ thị
+    writeFile(path, binaryFile(2, 1, {0, 1, 1, 1, 1, 5}));
+    EXPECT_FALSE(loadBinary(path, graph, nullptr, &error));
+    writeFile(path, binaryFile(2, 1, {0, 1, 1, 0, 2, 5}));
+    EXPECT_FALSE(loadBinary(path, graph, nullptr, &error));
+    std::remove(path.c_str());
+}
+
+} // namespace
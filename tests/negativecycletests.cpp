@@ -0,0 +1,85 @@
+// Tìm chu trình âm trên toàn đồ thị và các đỉnh -vô cùng tính từ một nguồn.
+#include "testgraphs.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+TEST(NegativeCycles, FoundAnywhereInGraph) {
+    std::mt19937 rng(777);
+    for (int trial = 0; trial < 100; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 60);
+        randomGraph(graph, n, n * 2, trial % 2 == 1, rng);
+        bool anySource = false;
+        for (int s = 0; s < n && !anySource; ++s)
+            anySource = graph.bellmanFord(s, false).hasNegativeCycle;
+
+        SCOPED_TRACE(testing::Message() << "lần " << trial);
+        const std::vector<int> cycle = graph.findNegativeCycle(1 + trial % 4);
+        ASSERT_EQ(!cycle.empty(), anySource);
+        if (!cycle.empty()) {
+            EXPECT_LT(walkWeight(graph, cycle, true), 0);
+        }
+    }
+}
+
+TEST(NegativeCycles, LargeWeightsFoundWithDefaultThreads) {
+    std::mt19937 rng(716);
+    int withCycle = 0;
+    for (int trial = 0; trial < 200; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 10);
+        largeWeightGraph(graph, n, n + static_cast<int>(rng() % (2 * n)), false, rng);
+        // Mọi chu trình âm đều tới được từ một đỉnh của nó
+        bool anySource = false;
+        for (int s = 0; s < n && !anySource; ++s)
+            anySource = referencePaths(graph, s).hasNegativeCycle;
+        withCycle += anySource;
+
+        SCOPED_TRACE(testing::Message() << "lần " << trial);
+        const std::vector<int> cycle = graph.findNegativeCycle();
+        ASSERT_EQ(!cycle.empty(), anySource);
+        if (!cycle.empty()) {
+            EXPECT_LT(walkWeight(graph, cycle, true), 0);
+        }
+    }
+    EXPECT_GT(withCycle, 20);
+}
+
+TEST(NegativeCycles, UnboundedVerticesMatchReference) {
+    const SolverMode modes[] = {
+        SolverMode::Auto, SolverMode::BellmanFord, SolverMode::EarlyExit,
+        SolverMode::Spfa, SolverMode::Parallel, SolverMode::Vectorized
+    };
+    std::mt19937 rng(715);
+    int withCycle = 0;
+    for (int trial = 0; trial < 300; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 40);
+        // Xen kẽ trọng số nhỏ (nhiều chu trình, đỉnh -vô cùng ở xa chu trình) với trọng số gần giới hạn int
+        if (trial % 2 == 0)
+            randomGraph(graph, n, n * 2, true, rng);
+        else
+            largeWeightGraph(graph, n, n + static_cast<int>(rng() % (2 * n)), false, rng);
+        const int source = static_cast<int>(rng() % n);
+        const ReferencePaths expected = referencePaths(graph, source);
+        withCycle += expected.hasNegativeCycle;
+
+        for (SolverMode mode : modes) {
+            SolverOptions options;
+            options.mode = mode;
+            options.threadCount = 1 + trial % 4;
+            SCOPED_TRACE(testing::Message() << "lần " << trial << ", chế độ " << static_cast<int>(mode));
+            const ShortestPathResult result = graph.shortestPaths(source, options);
+            ASSERT_EQ(result.hasNegativeCycle, expected.hasNegativeCycle);
+            std::vector<char> unbounded(n, 0);
+            for (int v : graph.unboundedVertices(result))
+                unbounded[v] = 1;
+            EXPECT_EQ(unbounded, expected.unbounded);
+        }
+    }
+    EXPECT_GT(withCycle, 50);
+}
+
+} // namespace
@@ -0,0 +1,51 @@
+// Nhân relax AVX2 phải hội tụ về cùng khoảng cách với nhân vô hướng, kể cả khi tổng bão hòa.
+#include "relaxkernel.h"
+#include <gtest/gtest.h>
+#include <climits>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Lặp nhân tới khi không còn cập nhật; cạnh luôn đi từ đỉnh số nhỏ sang số lớn nên phải dừng
+std::vector<int> relaxUntilStable(RelaxKernel kernel, const std::vector<int> &from, const std::vector<int> &to,
+                                  const std::vector<int> &weight, int vertexCount) {
+    std::vector<int> distance(vertexCount, INT_MAX);
+    std::vector<int> previous(vertexCount, -1);
+    distance[0] = 0;
+    for (int round = 0; round < vertexCount; ++round) {
+        if (!kernel(from.data(), to.data(), weight.data(), static_cast<int>(from.size()),
+                    distance.data(), previous.data()))
+            break;
+    }
+    return distance;
+}
+
+TEST(RelaxKernels, Avx2MatchesScalar) {
+    if (!cpuSupportsAvx2())
+        GTEST_SKIP() << "CPU không hỗ trợ AVX2";
+    const int weights[] = {INT_MIN, -2000000000, -1000000000, -3, 0, 4, 1000000000, 2000000000, INT_MAX};
+    std::mt19937 rng(505);
+    for (int trial = 0; trial < 200; ++trial) {
+        const int n = 2 + static_cast<int>(rng() % 30);
+        const int m = static_cast<int>(rng() % (4 * n));
+        std::vector<int> from, to, weight;
+        for (int e = 0; e < m; ++e) {
+            int u = static_cast<int>(rng() % n);
+            int v = static_cast<int>(rng() % n);
+            if (u == v)
+                continue;
+            if (u > v)
+                std::swap(u, v);
+            from.push_back(u);
+            to.push_back(v);
+            weight.push_back(weights[rng() % (sizeof(weights) / sizeof(weights[0]))]);
+        }
+        SCOPED_TRACE(testing::Message() << "lần " << trial);
+        EXPECT_EQ(relaxUntilStable(relaxEdgesAvx2, from, to, weight, n),
+                  relaxUntilStable(relaxEdgesScalar, from, to, weight, n));
+    }
+}
+
+} // namespace
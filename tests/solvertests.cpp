@@ -0,0 +1,161 @@
+// Đối chiếu các chế độ giải với Bellman-Ford đủ vertices - 1 lượt (bellmanFord(source, false))
+// trên đồ thị ngẫu nhiên có cạnh âm và chu trình âm.
+// Chạy: fordbellman_tests hoặc ctest trong thư mục dựng.
+#include "testgraphs.h"
+#include <gtest/gtest.h>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+const SolverMode AllModes[] = {
+    SolverMode::Auto, SolverMode::BellmanFord, SolverMode::EarlyExit,
+    SolverMode::Spfa, SolverMode::Parallel, SolverMode::Vectorized
+};
+
+// Đồ thị nhỏ có trọng số gần giới hạn int, mỗi chế độ trong modes đối chiếu với referencePaths
+void expectLargeWeightsMatch(const std::vector<SolverMode> &modes, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    int withCycle = 0;
+    int overflowed = 0;
+    for (int trial = 0; trial < 300; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 10);
+        largeWeightGraph(graph, n, n + static_cast<int>(rng() % (2 * n)), trial % 2 == 0, rng);
+        const int source = static_cast<int>(rng() % n);
+        const ReferencePaths expected = referencePaths(graph, source);
+        withCycle += expected.hasNegativeCycle;
+        overflowed += expected.overflowed;
+
+        for (SolverMode mode : modes) {
+            SolverOptions options;
+            options.mode = mode;
+            options.threadCount = 1 + trial % 4;
+            SCOPED_TRACE(testing::Message() << "lần " << trial << ", chế độ " << static_cast<int>(mode));
+            expectMatchesReference(graph, graph.shortestPaths(source, options), expected);
+        }
+    }
+    // Phải có đủ cả đồ thị có chu trình âm lẫn đồ thị chỉ có đường đi vượt INT_MIN
+    EXPECT_GT(withCycle, 10);
+    EXPECT_GT(overflowed, 10);
+}
+
+TEST(SolverModes, MatchFullBellmanFord) {
+    std::mt19937 rng(12345);
+    int withCycle = 0;
+    for (int trial = 0; trial < 200; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 80);
+        randomGraph(graph, n, n * (1 + static_cast<int>(rng() % 4)), trial % 2 == 1, rng);
+        const int source = static_cast<int>(rng() % n);
+        const ShortestPathResult expected = graph.bellmanFord(source, false);
+        withCycle += expected.hasNegativeCycle;
+
+        for (SolverMode mode : AllModes) {
+            SolverOptions options;
+            options.mode = mode;
+            options.threadCount = 1 + trial % 4;
+            SCOPED_TRACE(testing::Message() << "lần " << trial << ", chế độ " << static_cast<int>(mode));
+            const ShortestPathResult result = graph.shortestPaths(source, options);
+            ASSERT_FALSE(result.cancelled);
+            ASSERT_EQ(result.hasNegativeCycle, expected.hasNegativeCycle);
+            if (result.hasNegativeCycle) {
+                // Johnson báo chu trình qua Bellman-Ford dự phòng nên mọi chế độ đều phải trả về chu trình
+                ASSERT_FALSE(result.negativeCycle.empty());
+                EXPECT_LT(walkWeight(graph, result.negativeCycle, true), 0);
+                continue;
+            }
+            EXPECT_EQ(result.distance, expected.distance);
+            expectConsistentPaths(graph, result);
+        }
+    }
+    // Bộ sinh phải thực sự tạo ra cả hai loại đồ thị
+    EXPECT_GT(withCycle, 20);
+    EXPECT_LT(withCycle, 180);
+}
+
+TEST(SolverModes, ParallelProgressTracksDistances) {
+    // Mỗi lượt chỉ chép các đỉnh frontier ra bản khoảng cách báo tiến độ; bản đó vẫn phải khớp
+    // với khoảng cách thật ở mọi lượt, và ở lượt cuối bằng kết quả
+    std::mt19937 rng(1010);
+    for (int trial = 0; trial < 40; ++trial) {
+        GraphEngine graph;
+        const int n = 2 + static_cast<int>(rng() % 200);
+        randomGraph(graph, n, n * 3, false, rng);
+        const int source = static_cast<int>(rng() % n);
+        std::vector<int> last;
+        int reports = 0;
+        ProgressCallback progress = [&](const SolverProgress &state) {
+            std::vector<int> snapshot(state.distance, state.distance + n);
+            // Khoảng cách chỉ giảm dần giữa các lượt
+            for (int v = 0; v < n && !last.empty(); ++v)
+                EXPECT_LE(snapshot[v], last[v]);
+            last = snapshot;
+            ++reports;
+            return true;
+        };
+        SCOPED_TRACE(testing::Message() << "lần " << trial);
+        const ShortestPathResult result = graph.parallelBellmanFord(source, 1 + trial % 4, progress);
+        ASSERT_FALSE(result.hasNegativeCycle);
+        ASSERT_GT(reports, 0);
+        EXPECT_EQ(last, result.distance);
+        EXPECT_EQ(result.distance, graph.bellmanFord(source, false).distance);
+    }
+}
+
+TEST(LargeWeights, AcyclicOverflowIsNotANegativeCycle) {
+    // 0 -> 1 -> 2 -> 3 không có chu trình nhưng tổng xuống dưới INT_MIN từ đỉnh 2
+    GraphEngine graph;
+    for (int v = 0; v < 4; ++v)
+        graph.addVertex();
+    graph.addEdge(0, 1, -2000000000);
+    graph.addEdge(1, 2, -2000000000);
+    graph.addEdge(2, 3, -5);
+    for (SolverMode mode : AllModes) {
+        SolverOptions options;
+        options.mode = mode;
+        SCOPED_TRACE(testing::Message() << "chế độ " << static_cast<int>(mode));
+        const ShortestPathResult result = graph.shortestPaths(0, options);
+        EXPECT_FALSE(result.hasNegativeCycle);
+        EXPECT_TRUE(result.overflowed);
+        EXPECT_EQ(result.distance, std::vector<int>({0, -2000000000, INT_MIN, INT_MIN}));
+        EXPECT_EQ(result.pathTo(3), std::vector<int>({0, 1, 2, 3}));
+    }
+}
+
+TEST(LargeWeights, BellmanFordAndSpfaMatchReference) {
+    expectLargeWeightsMatch({SolverMode::BellmanFord, SolverMode::EarlyExit, SolverMode::Spfa}, 2002);
+}
+
+TEST(LargeWeights, ParallelMatchesReference) {
+    expectLargeWeightsMatch({SolverMode::Parallel}, 2004);
+}
+
+TEST(LargeWeights, VectorizedMatchesReference) {
+    // Nhân AVX2 (nếu CPU có) cộng bão hòa: tổng dưới INT_MIN phải vẫn là cập nhật
+    expectLargeWeightsMatch({SolverMode::Vectorized}, 2005);
+}
+
+TEST(LargeWeights, JohnsonMatchesReference) {
+    // Auto chạy Johnson (có cạnh âm) với thế năng có thể nhỏ hơn INT_MIN
+    expectLargeWeightsMatch({SolverMode::Auto}, 2003);
+}
+
+TEST(LargeWeights, JohnsonPotentialBelowIntMin) {
+    // Thế năng của đỉnh 2, 3 nhỏ hơn INT_MIN: Johnson vẫn phải tự giải, không coi là chu trình âm
+    GraphEngine graph;
+    for (int v = 0; v < 4; ++v)
+        graph.addVertex();
+    graph.addEdge(0, 1, -2000000000);
+    graph.addEdge(1, 2, -2000000000);
+    graph.addEdge(2, 3, -5);
+    const ShortestPathResult result = graph.johnson(1);
+    ASSERT_FALSE(result.distance.empty());
+    EXPECT_FALSE(result.hasNegativeCycle);
+    EXPECT_FALSE(result.overflowed);
+    EXPECT_EQ(result.distance, std::vector<int>({GraphEngine::Infinity, 0, -2000000000, -2000000005}));
+    EXPECT_TRUE(graph.johnson(0).overflowed);
+}
+
+} // namespace
@@ -0,0 +1,129 @@
+#include "testgraphs.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+void randomGraph(GraphEngine &graph, int vertexCount, int edgeCount, bool withCycle, std::mt19937 &rng) {
+    std::vector<int> shift(vertexCount);
+    for (int &p : shift)
+        p = static_cast<int>(rng() % 50);
+    for (int v = 0; v < vertexCount; ++v)
+        graph.addVertex();
+    for (int e = 0; e < edgeCount; ++e) {
+        const int u = static_cast<int>(rng() % vertexCount);
+        const int v = static_cast<int>(rng() % vertexCount);
+        graph.addEdge(u, v, static_cast<int>(rng() % 30) + shift[u] - shift[v]);
+    }
+    if (withCycle) {
+        for (int i = 0; i < 3; ++i)
+            graph.addEdge(static_cast<int>(rng() % vertexCount), static_cast<int>(rng() % vertexCount), -60);
+    }
+}
+
+void largeWeightGraph(GraphEngine &graph, int vertexCount, int edgeCount, bool acyclic, std::mt19937 &rng) {
+    const int weights[] = {INT_MIN, -2000000000, -1000000000, -7, 0, 5, 1000000000, 2000000000, INT_MAX};
+    const int choices = static_cast<int>(sizeof(weights) / sizeof(weights[0]));
+    for (int v = 0; v < vertexCount; ++v)
+        graph.addVertex();
+    for (int e = 0; e < edgeCount; ++e) {
+        int u = static_cast<int>(rng() % vertexCount);
+        int v = static_cast<int>(rng() % vertexCount);
+        if (acyclic && u == v)
+            continue;
+        if (acyclic && u > v)
+            std::swap(u, v);
+        graph.addEdge(u, v, weights[rng() % choices]);
+    }
+}
+
+ReferencePaths referencePaths(const GraphEngine &graph, int source) {
+    const int n = graph.vertexCount();
+    ReferencePaths reference;
+    reference.distance.assign(n, LLONG_MAX);
+    reference.unbounded.assign(n, 0);
+    reference.distance[source] = 0;
+
+    // Sau n - 1 lượt, đỉnh còn giảm được là đỉnh đi qua chu trình âm; n lượt nữa đủ để lan
+    // dấu -vô cùng tới mọi đỉnh đi tới được từ đó
+    for (int round = 0; round < 2 * n; ++round) {
+        for (int e = 0; e < graph.edgeCount(); ++e) {
+            const int u = graph.edgeSource(e);
+            const int v = graph.edgeTarget(e);
+            // Đỉnh -vô cùng lan qua mọi cạnh, kể cả cạnh INT_MAX đi ra từ đỉnh chưa có khoảng cách hữu hạn
+            if (reference.unbounded[u]) {
+                reference.unbounded[v] = 1;
+                continue;
+            }
+            if (reference.distance[u] == LLONG_MAX)
+                continue;
+            const long long candidate = reference.distance[u] + graph.edgeWeight(e);
+            if (candidate < reference.distance[v] && candidate < INT_MAX) {
+                reference.distance[v] = candidate;
+                if (round >= n - 1)
+                    reference.unbounded[v] = 1;
+            }
+        }
+    }
+    for (int v = 0; v < n; ++v) {
+        if (reference.unbounded[v])
+            reference.hasNegativeCycle = true;
+        else if (reference.distance[v] < INT_MIN)
+            reference.overflowed = true;
+    }
+    if (reference.hasNegativeCycle)
+        reference.overflowed = false;
+    return reference;
+}
+
+void expectMatchesReference(const GraphEngine &graph, const ShortestPathResult &result, const ReferencePaths &expected) {
+    ASSERT_FALSE(result.cancelled);
+    ASSERT_EQ(result.hasNegativeCycle, expected.hasNegativeCycle);
+    if (result.hasNegativeCycle) {
+        ASSERT_FALSE(result.negativeCycle.empty());
+        EXPECT_LT(walkWeight(graph, result.negativeCycle, true), 0);
+        return;
+    }
+    EXPECT_EQ(result.overflowed, expected.overflowed);
+    for (int v = 0; v < graph.vertexCount(); ++v) {
+        const int distance = expected.distance[v] == LLONG_MAX ? GraphEngine::Infinity
+                                                               : GraphEngine::clampDistance(expected.distance[v]);
+        EXPECT_EQ(result.distance[v], distance) << "đỉnh " << v;
+    }
+    expectConsistentPaths(graph, result);
+}
+
+long long minEdgeWeight(const GraphEngine &graph, int u, int v) {
+    long long best = LLONG_MAX;
+    for (int e = 0; e < graph.edgeCount(); ++e) {
+        if (graph.edgeSource(e) == u && graph.edgeTarget(e) == v)
+            best = std::min<long long>(best, graph.edgeWeight(e));
+    }
+    return best;
+}
+
+long long walkWeight(const GraphEngine &graph, const std::vector<int> &walk, bool cycle) {
+    if (walk.empty())
+        return LLONG_MAX;
+    long long total = 0;
+    const size_t steps = cycle ? walk.size() : walk.size() - 1;
+    for (size_t i = 0; i < steps; ++i) {
+        const long long w = minEdgeWeight(graph, walk[i], walk[(i + 1) % walk.size()]);
+        if (w == LLONG_MAX)
+            return LLONG_MAX;
+        total += w;
+    }
+    return total;
+}
+
+void expectConsistentPaths(const GraphEngine &graph, const ShortestPathResult &result) {
+    for (int v = 0; v < graph.vertexCount(); ++v) {
+        if (!result.reachable(v))
+            continue;
+        const std::vector<int> path = result.pathTo(v);
+        ASSERT_FALSE(path.empty()) << "đỉnh " << v;
+        EXPECT_EQ(path.front(), result.source);
+        // Đỉnh bị ghim ở INT_MIN có đường đi thật nhỏ hơn khoảng cách lưu được
+        EXPECT_EQ(GraphEngine::clampDistance(walkWeight(graph, path, false)), result.distance[v]) << "đỉnh " << v;
+    }
+}
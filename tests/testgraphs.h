@@ -0,0 +1,42 @@
+#ifndef TESTGRAPHS_H
+#define TESTGRAPHS_H
+
+#include "graphengine.h"
+#include <random>
+#include <vector>
+
+// Đồ thị ngẫu nhiên và các phép kiểm tra dùng chung giữa các file test.
+
+// Trọng số w + p(u) - p(v) với w >= 0 không tạo chu trình âm nhưng cho nhiều cạnh âm;
+// khi withCycle thì thêm vài cạnh âm mạnh để (có thể) khép thành chu trình âm
+void randomGraph(GraphEngine &graph, int vertexCount, int edgeCount, bool withCycle, std::mt19937 &rng);
+
+// Trọng số lấy từ các giá trị gần giới hạn int (±2e9, INT_MIN, INT_MAX...) lẫn với số nhỏ, để
+// đường đi vượt phạm vi int cả khi có và không có chu trình âm. acyclic: mọi cạnh đi từ đỉnh số nhỏ
+// sang đỉnh số lớn hơn nên không có chu trình nào
+void largeWeightGraph(GraphEngine &graph, int vertexCount, int edgeCount, bool acyclic, std::mt19937 &rng);
+
+// Kết quả đúng tính bằng Bellman-Ford trên long long, không ghim giá trị nào
+struct ReferencePaths {
+    std::vector<long long> distance;  // LLONG_MAX nếu không tới được; không dùng với đỉnh -vô cùng
+    std::vector<char> unbounded;      // Đỉnh có khoảng cách -vô cùng
+    bool hasNegativeCycle = false;
+    bool overflowed = false;          // Có đỉnh không -vô cùng với khoảng cách nhỏ hơn INT_MIN
+};
+// Như GraphEngine, tổng từ INT_MAX trở lên được coi là không tới được
+ReferencePaths referencePaths(const GraphEngine &graph, int source);
+
+// result phải khớp với referencePaths: cờ chu trình, chu trình âm thật,
+// khoảng cách (ghim ở INT_MIN), cờ overflowed và cây đường đi
+void expectMatchesReference(const GraphEngine &graph, const ShortestPathResult &result, const ReferencePaths &expected);
+
+// Trọng số nhỏ nhất của cạnh u -> v, LLONG_MAX nếu không có
+long long minEdgeWeight(const GraphEngine &graph, int u, int v);
+
+// Tổng trọng số của đường đi (cycle = true: có thêm cạnh quay về đỉnh đầu), LLONG_MAX nếu thiếu cạnh
+long long walkWeight(const GraphEngine &graph, const std::vector<int> &walk, bool cycle);
+
+// Cây đường đi của result phải khớp với khoảng cách của nó
+void expectConsistentPaths(const GraphEngine &graph, const ShortestPathResult &result);
+
+#endif // TESTGRAPHS_H